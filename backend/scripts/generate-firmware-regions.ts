@@ -0,0 +1,144 @@
+/**
+ * Firmware Region Table Generator
+ * Weather Display System - keeps the device's station/region tables in sync with the backend
+ *
+ * Writes firmware/weather-display-integrated/regions_generated.h from
+ * src/config/regions.ts. Run after changing regions or stations:
+ *
+ *   npm run generate:firmware-regions
+ */
+
+import { writeFileSync } from 'node:fs';
+import { dirname, resolve } from 'node:path';
+import { fileURLToPath } from 'node:url';
+import { REGIONS, STATION_DISPLAY_NAMES } from '../src/config/regions.js';
+
+const OUTPUT = resolve(
+  dirname(fileURLToPath(import.meta.url)),
+  '../../firmware/weather-display-integrated/regions_generated.h'
+);
+
+// Display units per m/s - same factors as convertWindSpeedForRegion()
+const SPEED_UNITS = [
+  { code: 'mps', enumName: 'UNIT_MPS', label: 'm/s', perMps: 1 },
+  { code: 'kph', enumName: 'UNIT_KPH', label: 'kph', perMps: 3.6 },
+  { code: 'kts', enumName: 'UNIT_KTS', label: 'kts', perMps: 1.94384 },
+  { code: 'mph', enumName: 'UNIT_MPH', label: 'mph', perMps: 2.237 }
+];
+const SPEED_FACTOR_SCALE = 100000;
+
+function cString(value: string): string {
+  if (!/^[\x20-\x7e]*$/.test(value)) {
+    throw new Error(`Non-ASCII text cannot be drawn by the firmware fonts: ${value}`);
+  }
+  return JSON.stringify(value);
+}
+
+const regions = Object.values(REGIONS);
+const stations = regions.flatMap((region, regionIndex) =>
+  region.stations.map(stationId => ({ stationId, regionIndex }))
+);
+const maxStations = Math.max(...regions.map(region => region.stations.length));
+
+const stationIndex = (stationId: string): number => {
+  const index = stations.findIndex(station => station.stationId === stationId);
+  if (index < 0) {
+    throw new Error(`Unknown station: ${stationId}`);
+  }
+  return index;
+};
+
+const unitLines = SPEED_UNITS.map((unit, index) =>
+  `  ${unit.enumName}${index === 0 ? ' = 0' : ''}`
+).join(',\n');
+
+const unitRows = SPEED_UNITS.map(unit =>
+  `  {${cString(unit.label)}, ${Math.round(unit.perMps * SPEED_FACTOR_SCALE)}}`
+).join(',\n');
+
+const stationRows = stations.map(({ stationId, regionIndex }) => {
+  const displayName = STATION_DISPLAY_NAMES[stationId];
+  if (!displayName) {
+    throw new Error(`Missing STATION_DISPLAY_NAMES entry for ${stationId}`);
+  }
+  return `  {regionIdHash(${cString(stationId)}), ${cString(stationId)}, ${cString(displayName)}, ${regionIndex}}`;
+}).join(',\n');
+
+const regionRows = regions.map(region => {
+  const unit = SPEED_UNITS.find(candidate => candidate.code === region.displayUnit);
+  if (!unit) {
+    throw new Error(`Unknown display unit for ${region.name}: ${region.displayUnit}`);
+  }
+  const indices = region.stations.map(stationIndex);
+  while (indices.length < maxStations) {
+    indices.push(0xff);
+  }
+  return `  {regionIdHash(${cString(region.name)}), ${cString(region.name)}, ${cString(region.displayName)}, ` +
+    `${unit.enumName}, ${stationIndex(region.defaultStation)}, ${region.stations.length}, {${indices.join(', ')}}}`;
+}).join(',\n');
+
+const header = `/**
+ * Region and Station Tables
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * GENERATED by backend/scripts/generate-firmware-regions.ts from
+ * backend/src/config/regions.ts - do not edit by hand.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// FNV-1a of an ID in a constant expression (same hash as fnv1aHash() in the sketch)
+constexpr uint32_t regionIdHash(const char* id, uint32_t hash = 2166136261UL) {
+  return *id ? regionIdHash(id + 1, (hash ^ (uint8_t)*id) * 16777619UL) : hash;
+}
+
+enum SpeedUnit : uint8_t {
+${unitLines}
+};
+
+#define SPEED_FACTOR_SCALE ${SPEED_FACTOR_SCALE}
+#define REGION_MAX_STATIONS ${maxStations}
+#define STATION_NONE 0xFF
+
+struct SpeedUnitInfo {
+  const char* label;
+  uint32_t factor;          // Display units per m/s, times SPEED_FACTOR_SCALE
+};
+
+struct StationInfo {
+  uint32_t idHash;
+  const char* id;
+  const char* displayName;  // ASCII, as drawn on the panel
+  uint8_t region;           // Index into REGIONS
+};
+
+struct RegionInfo {
+  uint32_t idHash;
+  const char* id;
+  const char* displayName;
+  SpeedUnit displayUnit;
+  uint8_t defaultStation;   // Index into STATIONS
+  uint8_t stationCount;
+  uint8_t stations[REGION_MAX_STATIONS]; // Display order, indices into STATIONS
+};
+
+constexpr SpeedUnitInfo SPEED_UNITS[] = {
+${unitRows}
+};
+
+constexpr StationInfo STATIONS[] = {
+${stationRows}
+};
+
+constexpr RegionInfo REGIONS[] = {
+${regionRows}
+};
+
+constexpr int NUM_STATIONS = sizeof(STATIONS) / sizeof(STATIONS[0]);
+constexpr int NUM_REGIONS = sizeof(REGIONS) / sizeof(REGIONS[0]);
+`;
+
+writeFileSync(OUTPUT, header);
+console.log(`[INFO] Wrote ${stations.length} stations, ${regions.length} regions to ${OUTPUT}`);
@@ -11,6 +11,8 @@ export const REGIONS: Record<string, RegionConfig> = {
     displayName: 'Chamonix Valley, France',
     stations: ['prarion', 'planpraz', 'tetedebalme'], // Display order for firmware
     defaultStation: 'prarion', // Primary station
+    displayUnit: 'kph', // Alpine stations: km/h
+    timezone: 'Europe/Paris',
     forecast: {
       latitude: 45.9237,
       longitude: 6.8694,
@@ -23,6 +25,8 @@ export const REGIONS: Record<string, RegionConfig> = {
     displayName: 'Solent, UK',
     stations: ['lymington', 'brambles', 'seaview'], // Display order for firmware
     defaultStation: 'lymington', // Primary station
+    displayUnit: 'kts', // Marine stations: knots
+    timezone: 'Europe/London',
     forecast: {
       latitude: 50.7606,
       longitude: -1.2974,
@@ -34,6 +38,31 @@ export const REGIONS: Record<string, RegionConfig> = {
 
 export const DEFAULT_REGION = 'chamonix';
 
+/**
+ * Device poll schedule - the region endpoint sends the interval as a hint
+ */
+export const POLL_SCHEDULE = {
+  daySeconds: 180,       // Matches the firmware's WEATHER_UPDATE_INTERVAL
+  nightSeconds: 1800,    // Nobody reads a chalet or harbour office display overnight
+  nightStartHour: 22,    // Local time, inclusive
+  nightEndHour: 6,       // Local time, exclusive
+  minSeconds: 60,
+  maxSeconds: 3600
+};
+
+/**
+ * Station names as drawn by the firmware (ASCII only - the ePaper fonts have no accents).
+ * Firmware tables are generated from this file: npm run generate:firmware-regions
+ */
+export const STATION_DISPLAY_NAMES: Record<string, string> = {
+  prarion: 'Prarion',
+  planpraz: 'Planpraz',
+  tetedebalme: 'Tete de Balme',
+  lymington: 'Lymington',
+  brambles: 'Brambles',
+  seaview: 'Seaview'
+};
+
 /**
  * Get region configuration by name
  */
@@ -4,11 +4,18 @@ import { fetchLymingtonWeather, parseLymingtonData } from './parsers/lymington.j
 import { parsePioupiou521 } from './parsers/pioupiou.js';
 import { parseWindbird1702, parseWindbird1724 } from './parsers/windbird.js';
 import { fetchAndParseMeteoblueForecast } from './parsers/meteoblueForecast.js';
-import { WeatherResponse, RegionWeatherResponse, WeatherData, ForecastResponse, ForecastData, Env } from './types/weather.js';
-import { formatDisplayLines, createCacheKey, generateContentHash, convertWindSpeedForRegion } from './utils/helpers.js';
+import { WeatherResponse, WeatherData, ForecastResponse, ForecastData, Env } from './types/weather.js';
+import { formatDisplayLines, createCacheKey, generateContentHash, computeNextPollSeconds, convertWindSpeedForRegion } from './utils/helpers.js';
 
 // Device management imports
-import { DeviceInfo, DeviceRegistrationResponse, DeviceNotFoundError, InvalidMacAddressError } from './types/devices.js';
+import {
+  DeviceInfo,
+  DeviceCommandRequest,
+  DeviceRegistrationResponse,
+  DeviceNotFoundError,
+  InvalidDeviceCommandError,
+  InvalidMacAddressError
+} from './types/devices.js';
 import { getAllRegions, getRegion, getDefaultStation, DEFAULT_REGION, getRegionForStation } from './config/regions.js';
 import { 
   normalizeDeviceId, 
@@ -20,9 +27,26 @@ import {
   updateDeviceActivity,
   setDeviceIdentifyFlag,
   clearDeviceIdentifyFlag,
+  DEVICE_POLL,
+  enqueueDeviceCommand,
+  queueDeviceCommand,
+  parseCommandAck,
+  acknowledgeDeviceCommands,
+  waitForDeviceCommands,
   extractDeviceInfo,
+  parseEnergyTrace,
   getAllDevices 
 } from './utils/devices.js';
+import { REGION_BINARY_CONTENT_TYPE, encodeCommandBlock } from './utils/regionBinary.js';
+import {
+  getRegionPayload,
+  getRegionSnapshot,
+  precomputeRegionPayloads,
+  regionPayloadBinary,
+  regionPayloadETag,
+  regionPayloadETagVersion
+} from './utils/regionPayload.js';
+import { fetchStations, fetchStationWithDeadline, readingAgeSeconds, storeLastGoodReading, StationReading } from './utils/stationFetch.js';
 
 
 
@@ -38,7 +62,7 @@ export default {
     const corsHeaders = {
       'Access-Control-Allow-Origin': '*',
       'Access-Control-Allow-Methods': 'GET, POST, PATCH, DELETE, OPTIONS',
-      'Access-Control-Allow-Headers': 'Content-Type, X-Device-MAC, X-Firmware-Version',
+      'Access-Control-Allow-Headers': 'Content-Type, X-Device-MAC, X-Firmware-Version, X-Device-Telemetry, X-Command-Ack, If-None-Match',
     };
     
     // Handle preflight requests
@@ -62,12 +86,16 @@ export default {
         return await handleGetDevicesRequest(env, corsHeaders);
       } else if (path === '/api/v1/devices' && request.method === 'POST') {
         return await handleCreateDeviceRequest(request, env, corsHeaders);
+      } else if (path.startsWith('/api/v1/devices/') && path.endsWith('/commands') && request.method === 'GET') {
+        return await handleCommandPollRequest(request, env, corsHeaders);
       } else if (path.startsWith('/api/v1/devices/') && request.method === 'GET') {
         return await handleGetDeviceRequest(request, env, corsHeaders);
       } else if (path.startsWith('/api/v1/devices/') && request.method === 'PATCH') {
         return await handleUpdateDeviceRequest(request, env, corsHeaders);
       } else if (path.startsWith('/api/v1/devices/') && path.endsWith('/identify') && request.method === 'POST') {
         return await handleIdentifyDeviceRequest(request, env, corsHeaders);
+      } else if (path.startsWith('/api/v1/devices/') && path.endsWith('/commands') && request.method === 'POST') {
+        return await handleQueueCommandRequest(request, env, corsHeaders);
       } else if (path.startsWith('/api/v1/devices/') && path.endsWith('/heartbeat') && request.method === 'POST') {
         return await handleHeartbeatRequest(request, env, corsHeaders);
       } else if (path === '/api/v1/collect' && request.method === 'POST') {
@@ -105,17 +133,14 @@ export default {
   async scheduled(event: ScheduledEvent, env: Env, ctx: ExecutionContext): Promise<void> {
     console.log('[INFO] Cron trigger executed:', event.cron);
     
-    // Collect weather data from all stations
+    // Collect weather data from all stations at once, each within its deadline
     const stations = ['brambles', 'seaview', 'lymington', 'prarion', 'tetedebalme', 'planpraz'];
+    const readings = await fetchStations(stations, env, ctx, collectStationData);
     
-    for (const stationId of stations) {
-      try {
-        console.log(`[INFO] Collecting data for station: ${stationId}`);
-        await collectStationData(stationId, env);
-      } catch (error) {
-        console.error(`[ERROR] Failed to collect data for ${stationId}:`, error);
-      }
-    }
+    // Build each region's device payload once from what was just collected
+    // (a failed station shows its last good reading or a placeholder)
+    await precomputeRegionPayloads(getAllRegions(), env,
+      async stationId => readings.get(stationId) ?? placeholderStation(stationId));
     
     // Check if this is an hourly trigger (for forecast collection)
     const currentMinute = new Date().getMinutes();
@@ -408,6 +433,9 @@ async function handleRegionWeatherRequest(
   const pathParts = url.pathname.split('/');
   const regionId = pathParts[5]; // /api/v1/weather/region/{region}
   const macParam = url.searchParams.get('mac'); // ?mac=deviceid for auto-registration
+  const binaryFormat = url.searchParams.get('format') === 'bin' ||
+    request.headers.get('Accept') === REGION_BINARY_CONTENT_TYPE; // Compact device payload
+  const deltaRequested = binaryFormat && url.searchParams.get('delta') === '1'; // Changed fields only
   
   if (!regionId) {
     return new Response(JSON.stringify({
@@ -442,6 +470,7 @@ async function handleRegionWeatherRequest(
     // Handle device auto-registration if MAC parameter provided
     let deviceRegistrationResponse: DeviceRegistrationResponse | null = null;
     let device: DeviceInfo | null = null;
+    const commandAck = parseCommandAck(request);
     
     if (macParam) {
       const deviceId = normalizeDeviceId(macParam);
@@ -465,6 +494,7 @@ async function handleRegionWeatherRequest(
           deviceInfo.firmware,
           deviceInfo.ipAddress
         );
+        device.telemetry = deviceInfo.telemetry;
         
         await saveDevice(device, env);
         
@@ -479,18 +509,26 @@ async function handleRegionWeatherRequest(
         
         console.log(`[INFO] New device auto-registered: ${deviceId} -> ${device.regionId}`);
       } else {
-        // Update existing device activity
+        // Update existing device activity - doubles as the heartbeat when the
+        // device sends X-Device-Telemetry (combined mode, one TLS session per cycle)
+        // The same save drops the commands the firmware acknowledged
         const deviceInfo = extractDeviceInfo(request);
-        const updatedDevice = updateDeviceActivity(
+        const updatedDevice = acknowledgeDeviceCommands(updateDeviceActivity(
           device,
           deviceInfo.ipAddress,
-          deviceInfo.userAgent
-        );
+          deviceInfo.userAgent,
+          deviceInfo.telemetry,
+          deviceInfo.firmware
+        ), commandAck);
         
         await saveDevice(updatedDevice, env);
         device = updatedDevice;
         
-        console.log(`[INFO] Device activity updated: ${deviceId}`);
+        if (deviceInfo.telemetry) {
+          console.log(`[INFO] Heartbeat recorded from weather poll: ${deviceId}`);
+        } else {
+          console.log(`[INFO] Device activity updated: ${deviceId}`);
+        }
       }
     }
     
@@ -502,60 +540,94 @@ async function handleRegionWeatherRequest(
       throw new Error(`Invalid target region: ${targetRegionId}`);
     }
     
-    // Collect data from all stations in the region (in correct display order)
-    const stationPromises = targetRegionConfig.stations.map(async (stationId) => {
-      // Try cache first
-      const cacheKey = createCacheKey(stationId);
-      const cachedData = await env.WEATHER_CACHE.get(cacheKey, { type: 'json' });
-      
-      if (cachedData) {
-        console.log(`[INFO] Serving cached data for ${stationId}`);
-        return cachedData as WeatherResponse;
-      } else {
-        console.log(`[INFO] Fetching fresh data for ${stationId}`);
-        const freshData = await collectStationData(stationId, env);
-        if (!freshData) {
-          console.warn(`[WARN] No data available for ${stationId}, using placeholder`);
-          // Return placeholder data to maintain 3-station structure
-          return {
-            schema: "weather.v1" as const,
-            stationId,
-            timestamp: new Date().toISOString(),
-            data: {
-              wind: {
-                avg: 0,
-                gust: 0,
-                direction: 0,
-                unit: "mps" as const
-              }
-            },
-            ttl: 300,
-            error: 'No data available'
-          };
-        }
-        return freshData;
-      }
-    });
+    // Precomputed by the cron trigger - one KV read instead of a station fan-out
+    const { payload, cacheHit } = await getRegionPayload(
+      targetRegionConfig,
+      env,
+      ctx,
+      stationId => loadRegionStation(stationId, env, ctx)
+    );
+    const payloadCache = cacheHit ? 'hit' : 'miss';
+    
+    // Per-station age at serving time (the stored payload is shared)
+    const now = Date.now();
+    const regionResponse = {
+      ...payload.response,
+      stations: payload.response.stations.map(station => ({
+        ...station,
+        ageSeconds: readingAgeSeconds(station, now)
+      }))
+    };
     
-    // Wait for all station data to be collected
-    const stationData = await Promise.all(stationPromises);
+    // Pending commands ride along until acknowledged - only for firmware that
+    // acknowledges (sends X-Command-Ack), older units keep the identify flag
+    const commands = device && commandAck !== null ? device.commands ?? [] : [];
     
-    // Create region response
-    const regionResponse: RegionWeatherResponse = {
-      schema: "weather-region.v1",
-      regionId: targetRegionId,
-      regionName: targetRegionConfig.displayName,
-      timestamp: new Date().toISOString(),
-      stations: stationData,
-      ttl: 300 // 5 minutes
-    };
+    // Conditional GET: unchanged content (including the identify flag) gets a
+    // bodyless 304 so the device skips the download, parse and panel refresh.
+    // Registration responses and pending commands always carry a body (the
+    // ETag stays the content's, so the acknowledging poll can get its 304).
+    const identify = device?.identifyFlag || false;
+    const etag = regionPayloadETag(payload, identify, binaryFormat ? 'bin' : 'json');
+    
+    // Poll hint for the device scheduler - sent as a header so 304s carry it too
+    const nextPollSeconds = computeNextPollSeconds(targetRegionConfig, device?.pollIntervalSeconds);
+    const ifNoneMatch = request.headers.get('If-None-Match');
+    
+    // Device responses carry that device's commands, identify bit and poll hint -
+    // never let a shared cache hand them to another device
+    const cacheControl = device ? 'private, no-store' : 'public, max-age=300'; // 5 minutes
+    
+    if (!deviceRegistrationResponse && commands.length === 0 && ifNoneMatch === etag) {
+      return new Response(null, {
+        status: 304,
+        headers: {
+          'ETag': etag,
+          'X-Next-Poll': String(nextPollSeconds),
+          'X-Payload-Cache': payloadCache,
+          'Cache-Control': cacheControl,
+          ...corsHeaders
+        }
+      });
+    }
+    
+    // Compact binary payload - registration (201) stays JSON so the firmware
+    // can read the assigned region
+    if (binaryFormat && !deviceRegistrationResponse) {
+      if (device?.identifyFlag) {
+        await clearDeviceIdentifyFlag(device.deviceId, env);
+      }
+      
+      // Delta mode: changes against the version the device holds (its
+      // If-None-Match), while that version's snapshot is still stored
+      const baseVersion = deltaRequested ? regionPayloadETagVersion(ifNoneMatch) : null;
+      const base = !baseVersion ? null
+        : baseVersion === payload.version ? payload.binary
+        : await getRegionSnapshot(payload.response.regionId, baseVersion, env);
+      const body = regionPayloadBinary(payload, identify, commands, base);
+      
+      return new Response(body.bytes, {
+        headers: {
+          'Content-Type': REGION_BINARY_CONTENT_TYPE,
+          // A delta is against this request's If-None-Match
+          'Cache-Control': body.delta ? 'private, no-store' : cacheControl,
+          'ETag': etag,
+          'X-Next-Poll': String(nextPollSeconds),
+          'X-Payload-Cache': payloadCache,
+          ...(body.delta && baseVersion ? { 'X-Delta-Base': baseVersion } : {}),
+          ...corsHeaders
+        }
+      });
+    }
     
     // For device requests, enhance the response with device-specific data
     if (device) {
       const deviceResponse = {
         ...regionResponse,
         // Add device-specific fields
-        identify: device.identifyFlag || false,
+        identify,
+        commands,
+        nextPollSeconds,
         deviceRegistration: deviceRegistrationResponse
       };
       
@@ -570,7 +642,10 @@ async function handleRegionWeatherRequest(
         status: statusCode,
         headers: {
           'Content-Type': 'application/json',
-          'Cache-Control': 'public, max-age=300', // 5 minutes
+          'Cache-Control': cacheControl,
+          'ETag': etag,
+          'X-Next-Poll': String(nextPollSeconds),
+          'X-Payload-Cache': payloadCache,
           ...corsHeaders
         }
       });
@@ -581,6 +656,9 @@ async function handleRegionWeatherRequest(
       headers: {
         'Content-Type': 'application/json',
         'Cache-Control': 'public, max-age=300', // 5 minutes
+        'ETag': etag,
+        'X-Next-Poll': String(nextPollSeconds),
+        'X-Payload-Cache': payloadCache,
         ...corsHeaders
       }
     });
@@ -740,22 +818,18 @@ async function handleCollectRequest(
   const results: Record<string, any> = {};
   
   const stations = ['brambles', 'seaview', 'lymington', 'prarion', 'tetedebalme', 'planpraz']; // All stations available
+  const readings = await fetchStations(stations, env, ctx, collectStationData);
   
   for (const stationId of stations) {
-    try {
-      const data = await collectStationData(stationId, env);
-      results[stationId] = {
-        success: true,
-        timestamp: data?.timestamp || new Date().toISOString()
-      };
-    } catch (error) {
-      results[stationId] = {
-        success: false,
-        error: error instanceof Error ? error.message : 'Unknown error'
-      };
-    }
+    const reading = readings.get(stationId);
+    results[stationId] = reading
+      ? { success: !reading.stale, stale: reading.stale || false, timestamp: reading.timestamp, ageSeconds: readingAgeSeconds(reading) }
+      : { success: false, error: 'No data available' };
   }
   
+  await precomputeRegionPayloads(getAllRegions(), env,
+    async stationId => readings.get(stationId) ?? placeholderStation(stationId));
+  
   const totalTime = Date.now() - startTime;
   
   return new Response(JSON.stringify({
@@ -872,6 +946,46 @@ async function handleHealthRequest(corsHeaders: Record<string, string>): Promise
   });
 }
 
+/**
+ * One station of a region payload: the station cache, else a collection
+ * within the source's deadline (or its last good reading), else a placeholder
+ */
+async function loadRegionStation(
+  stationId: string,
+  env: Env,
+  ctx: ExecutionContext
+): Promise<StationReading> {
+  const cachedData = await env.WEATHER_CACHE.get(createCacheKey(stationId), { type: 'json' });
+  if (cachedData) {
+    return cachedData as WeatherResponse;
+  }
+  
+  console.log(`[INFO] Fetching fresh data for ${stationId}`);
+  return await fetchStationWithDeadline(stationId, env, ctx, collectStationData) ?? placeholderStation(stationId);
+}
+
+/**
+ * Placeholder that keeps a region's 3-station display order
+ */
+function placeholderStation(stationId: string): StationReading {
+  console.warn(`[WARN] No data available for ${stationId}, using placeholder`);
+  return {
+    schema: "weather.v1" as const,
+    stationId,
+    timestamp: new Date().toISOString(),
+    data: {
+      wind: {
+        avg: 0,
+        gust: 0,
+        direction: 0,
+        unit: "mps" as const
+      }
+    },
+    ttl: 300,
+    error: 'No data available'
+  };
+}
+
 /**
  * Collect data from a specific weather station and cache it
  */
@@ -1003,6 +1117,7 @@ async function collectStationData(stationId: string, env: Env): Promise<WeatherR
     await env.WEATHER_CACHE.put(cacheKey, JSON.stringify(response), {
       expirationTtl: response.ttl
     });
+    await storeLastGoodReading(response, env); // Fallback when the source misses its deadline
     
     const totalTime = Date.now() - startTime;
     console.log(`[INFO] Successfully collected and cached data for ${stationId} in ${totalTime}ms`);
@@ -1271,11 +1386,27 @@ async function handleUpdateDeviceRequest(
       regionId: body.regionId || device.regionId
     };
     
-    await saveDevice(updatedDevice, env);
+    // Poll interval override: a positive number sets it, null clears it
+    if (body.pollIntervalSeconds === null) {
+      delete updatedDevice.pollIntervalSeconds;
+    } else if (typeof body.pollIntervalSeconds === 'number' && body.pollIntervalSeconds > 0) {
+      updatedDevice.pollIntervalSeconds = body.pollIntervalSeconds;
+    }
+    
+    // Pushed to the device as commands rather than waiting for its next poll
+    let pushedDevice = updatedDevice;
+    if (pushedDevice.regionId !== device.regionId) {
+      pushedDevice = enqueueDeviceCommand(pushedDevice, 'region', pushedDevice.regionId).device;
+    }
+    if (pushedDevice.pollIntervalSeconds !== device.pollIntervalSeconds) {
+      pushedDevice = enqueueDeviceCommand(pushedDevice, 'interval', pushedDevice.pollIntervalSeconds ?? 0).device;
+    }
+    
+    await saveDevice(pushedDevice, env);
     
     console.log(`[INFO] Device updated: ${deviceId}`);
     
-    return new Response(JSON.stringify(updatedDevice, null, 2), {
+    return new Response(JSON.stringify(pushedDevice, null, 2), {
       headers: {
         'Content-Type': 'application/json',
         ...corsHeaders
@@ -1283,6 +1414,19 @@ async function handleUpdateDeviceRequest(
     });
     
   } catch (error) {
+    if (error instanceof InvalidDeviceCommandError) {
+      return new Response(JSON.stringify({
+        error: 'Bad Request',
+        message: error.message
+      }), {
+        status: 400,
+        headers: {
+          'Content-Type': 'application/json',
+          ...corsHeaders
+        }
+      });
+    }
+    
     console.error(`[ERROR] Update device failed for ${deviceId}:`, error);
     return new Response(JSON.stringify({
       error: 'Bad Request',
@@ -1366,6 +1510,185 @@ async function handleIdentifyDeviceRequest(
   }
 }
 
+/**
+ * Handle queue command request: POST /api/v1/devices/{deviceId}/commands
+ * Body {"type": "identify" | "region" | "interval" | "refresh", "value"?}. The
+ * command reaches the device with its next region poll, or within seconds
+ * while it holds a command long-poll.
+ */
+async function handleQueueCommandRequest(
+  request: Request,
+  env: Env,
+  corsHeaders: Record<string, string>
+): Promise<Response> {
+  const url = new URL(request.url);
+  const pathParts = url.pathname.split('/');
+  const deviceId = pathParts[4]; // /api/v1/devices/{deviceId}/commands
+  
+  if (!deviceId) {
+    return new Response(JSON.stringify({
+      error: 'Bad Request',
+      message: 'Device ID is required'
+    }), {
+      status: 400,
+      headers: {
+        'Content-Type': 'application/json',
+        ...corsHeaders
+      }
+    });
+  }
+  
+  try {
+    const body = await request.json().catch(() => null) as DeviceCommandRequest | null;
+    if (!body || typeof body.type !== 'string') {
+      throw new InvalidDeviceCommandError('Command type is required');
+    }
+    
+    const command = await queueDeviceCommand(deviceId, body.type, body.value, env);
+    
+    return new Response(JSON.stringify({
+      message: 'Command queued for device',
+      deviceId,
+      command
+    }, null, 2), {
+      status: 202,
+      headers: {
+        'Content-Type': 'application/json',
+        ...corsHeaders
+      }
+    });
+    
+  } catch (error) {
+    if (error instanceof DeviceNotFoundError) {
+      return new Response(JSON.stringify({
+        error: 'Not Found',
+        message: error.message
+      }), {
+        status: 404,
+        headers: {
+          'Content-Type': 'application/json',
+          ...corsHeaders
+        }
+      });
+    }
+    
+    if (error instanceof InvalidDeviceCommandError) {
+      return new Response(JSON.stringify({
+        error: 'Bad Request',
+        message: error.message
+      }), {
+        status: 400,
+        headers: {
+          'Content-Type': 'application/json',
+          ...corsHeaders
+        }
+      });
+    }
+    
+    console.error(`[ERROR] Queue command failed for ${deviceId}:`, error);
+    return new Response(JSON.stringify({
+      error: 'Internal Server Error',
+      message: 'Failed to queue command'
+    }), {
+      status: 500,
+      headers: {
+        'Content-Type': 'application/json',
+        ...corsHeaders
+      }
+    });
+  }
+}
+
+/**
+ * Handle command long-poll: GET /api/v1/devices/{deviceId}/commands?wait={seconds}[&format=bin]
+ * Acknowledges X-Command-Ack, then is held open until a command is pending
+ * (200, JSON or the binary command block) or the wait ends (204)
+ */
+async function handleCommandPollRequest(
+  request: Request,
+  env: Env,
+  corsHeaders: Record<string, string>
+): Promise<Response> {
+  const url = new URL(request.url);
+  const pathParts = url.pathname.split('/');
+  const deviceId = pathParts[4]; // /api/v1/devices/{deviceId}/commands
+  const binaryFormat = url.searchParams.get('format') === 'bin';
+  
+  if (!deviceId) {
+    return new Response(JSON.stringify({
+      error: 'Bad Request',
+      message: 'Device ID is required'
+    }), {
+      status: 400,
+      headers: {
+        'Content-Type': 'application/json',
+        ...corsHeaders
+      }
+    });
+  }
+  
+  const requestedWait = Number(url.searchParams.get('wait'));
+  const waitSeconds = Number.isFinite(requestedWait)
+    ? Math.min(Math.max(Math.floor(requestedWait), 0), DEVICE_POLL.maxWaitSeconds)
+    : 0;
+  
+  try {
+    const commands = await waitForDeviceCommands(deviceId, env, waitSeconds * 1000, parseCommandAck(request));
+    
+    if (commands === null) {
+      return new Response(JSON.stringify({
+        error: 'Not Found',
+        message: `Device not found: ${deviceId}`
+      }), {
+        status: 404,
+        headers: {
+          'Content-Type': 'application/json',
+          ...corsHeaders
+        }
+      });
+    }
+    
+    if (commands.length === 0) {
+      return new Response(null, { status: 204, headers: corsHeaders });
+    }
+    
+    console.log(`[INFO] ${commands.length} command(s) delivered by long-poll: ${deviceId}`);
+    
+    if (binaryFormat) {
+      return new Response(encodeCommandBlock(commands), {
+        headers: {
+          'Content-Type': REGION_BINARY_CONTENT_TYPE,
+          ...corsHeaders
+        }
+      });
+    }
+    
+    return new Response(JSON.stringify({
+      commands,
+      deviceId,
+      timestamp: new Date().toISOString()
+    }), {
+      headers: {
+        'Content-Type': 'application/json',
+        ...corsHeaders
+      }
+    });
+    
+  } catch (error) {
+    console.error(`[ERROR] Command poll failed for ${deviceId}:`, error);
+    return new Response(JSON.stringify({
+      error: 'Internal Server Error',
+      message: 'Failed to poll commands'
+    }), {
+      status: 500,
+      headers: {
+        'Content-Type': 'application/json',
+        ...corsHeaders
+      }
+    });
+  }
+}
+
 /**
  * Handle heartbeat request: POST /api/v1/devices/{deviceId}/heartbeat
  */
@@ -1410,9 +1733,18 @@ async function handleHeartbeatRequest(
     const updatedDevice = updateDeviceActivity(
       device,
       deviceInfo.ipAddress,
-      deviceInfo.userAgent
+      deviceInfo.userAgent,
+      deviceInfo.telemetry,
+      deviceInfo.firmware
     );
     
+    // Energy profiler trace (firmware ENERGY_TRACE_UPLOAD), served back by GET /api/v1/devices/{id}
+    const body = await request.json().catch(() => null);
+    const energyTrace = parseEnergyTrace(body, deviceInfo.firmware);
+    if (energyTrace) {
+      updatedDevice.energyTrace = energyTrace;
+    }
+    
     await saveDevice(updatedDevice, env);
     
     return new Response(JSON.stringify({
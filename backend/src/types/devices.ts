@@ -16,6 +16,70 @@ export interface DeviceInfo {
   userAgent?: string;    // Device user agent string
   ipAddress?: string;    // Last known IP address
   identifyFlag: boolean; // Trigger identify sequence on next poll
+  telemetry?: DeviceTelemetry; // Last reported device health (heartbeat or weather poll)
+  pollIntervalSeconds?: number; // Fixed poll interval for this device (overrides the regional schedule)
+  energyTrace?: EnergyTrace; // Last per-cycle energy trace uploaded with a heartbeat
+  commands?: DeviceCommand[]; // Queued for the device, oldest first, until it acknowledges them
+  lastCommandId?: number;     // Last command ID issued to this device
+}
+
+/**
+ * Command queued for a device, delivered with its region weather response (or
+ * the command long-poll) until a request acknowledges it with X-Command-Ack
+ */
+export type DeviceCommandType = 'identify' | 'region' | 'interval' | 'refresh';
+
+export interface DeviceCommand {
+  id: number;              // Increasing per device (never reused, even across re-registration)
+  type: DeviceCommandType;
+  value?: string | number; // region: regionId; interval: seconds (0 = regional schedule)
+  queuedAt: string;        // ISO timestamp
+}
+
+export interface DeviceCommandRequest {
+  type: DeviceCommandType;
+  value?: string | number;
+}
+
+/**
+ * Device telemetry, sent as the compact X-Device-Telemetry header
+ * ("rssi=-62;heap=182000;up=540000;cyc=42;awake=5400") on the region weather
+ * request so the heartbeat needs no separate TLS session
+ */
+export interface DeviceTelemetry {
+  rssi?: number;         // WiFi signal strength (dBm)
+  freeHeap?: number;     // Free heap (bytes)
+  uptimeMs?: number;     // Time since cold boot, including deep sleep (ms)
+  cycle?: number;        // Wake cycles since cold boot
+  awakeMs?: number;      // Awake time of the previous cycle (ms)
+  batteryMv?: number;    // Smoothed battery voltage (mV), absent without a battery
+  powerMode?: number;    // 0 = normal, 1 = conserve, 2 = critical
+  phasesMs?: Record<string, number>;     // Per-phase time of the last completed cycle (ms)
+  phasesAvgMs?: Record<string, number>;  // Per-phase mean over the device's recent cycles (ms)
+  chargeMas?: Record<string, number>;    // Per-phase charge of the last completed cycle (mA·s)
+  cycleChargeMas?: number;     // Last completed cycle, awake time plus the deep sleep after it (mA·s)
+  cycleChargeAvgMas?: number;  // Mean cycle charge over the device's recent cycles (mA·s)
+  chargeSource?: 'model' | 'shunt'; // Modelled from phase times, or sampled on a test rig
+  reportedAt: string;    // ISO timestamp when the backend received it
+}
+
+/**
+ * One cycle of the firmware energy profiler's RTC trace
+ */
+export interface EnergyTraceCycle {
+  cycle: number;
+  source: 'model' | 'shunt';
+  phasesMs: Record<string, number>;
+  chargeMas: Record<string, number>;  // Per phase - phases overlap, so they don't sum to awakeChargeMas
+  awakeChargeMas: number;
+  sleepChargeMas: number;
+  totalChargeMas: number;             // Awake plus deep sleep - the figure to compare builds by
+}
+
+export interface EnergyTrace {
+  reportedAt: string;
+  firmware?: string;
+  cycles: EnergyTraceCycle[];         // Oldest first
 }
 
 export interface DeviceRegistrationRequest {
@@ -38,6 +102,7 @@ export interface DeviceRegistrationResponse {
 export interface DeviceUpdateRequest {
   nickname?: string;
   regionId?: string;
+  pollIntervalSeconds?: number | null; // null clears the override
 }
 
 export interface DeviceHeartbeat {
@@ -53,6 +118,8 @@ export interface RegionConfig {
   displayName: string;
   stations: string[];
   defaultStation: string;
+  displayUnit: 'kph' | 'kts' | 'mph' | 'mps'; // Wind unit shown on the device
+  timezone: string;      // IANA zone for the device poll schedule (night hours)
   forecast: {
     latitude: number;
     longitude: number;
@@ -74,6 +141,13 @@ export class DeviceNotFoundError extends Error {
   }
 }
 
+export class InvalidDeviceCommandError extends Error {
+  constructor(message: string) {
+    super(message);
+    this.name = 'InvalidDeviceCommandError';
+  }
+}
+
 export class InvalidMacAddressError extends Error {
   constructor(mac: string) {
     super(`Invalid MAC address format: ${mac}`);
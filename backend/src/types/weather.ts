@@ -42,6 +42,8 @@ export interface WeatherResponse {
     formatted: string[];
   };
   ttl: number;
+  stale?: boolean;      // Last good reading, served because the source missed its deadline
+  ageSeconds?: number;  // Seconds since the reading was collected (region responses)
 }
 
 // Multi-station region response for ESP32C3 display
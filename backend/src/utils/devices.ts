@@ -3,8 +3,18 @@
  * Weather Display System - Device Registration & Management
  */
 
-import { DeviceInfo, DeviceNotFoundError, InvalidMacAddressError } from '../types/devices.js';
-import { generateDefaultNickname, getDefaultStation, DEFAULT_REGION } from '../config/regions.js';
+import {
+  DeviceInfo,
+  DeviceTelemetry,
+  DeviceCommand,
+  DeviceCommandType,
+  DeviceNotFoundError,
+  EnergyTrace,
+  EnergyTraceCycle,
+  InvalidDeviceCommandError,
+  InvalidMacAddressError
+} from '../types/devices.js';
+import { generateDefaultNickname, getDefaultStation, getRegion, DEFAULT_REGION } from '../config/regions.js';
 import { Env } from '../types/weather.js';
 
 /**
@@ -100,7 +110,9 @@ export function createNewDevice(
 export function updateDeviceActivity(
   device: DeviceInfo,
   ipAddress?: string,
-  userAgent?: string
+  userAgent?: string,
+  telemetry?: DeviceTelemetry,
+  firmware?: string
 ): DeviceInfo {
   return {
     ...device,
@@ -108,7 +120,9 @@ export function updateDeviceActivity(
     status: 'online',
     requestCount: device.requestCount + 1,
     ipAddress: ipAddress || device.ipAddress,
-    userAgent: userAgent || device.userAgent
+    userAgent: userAgent || device.userAgent,
+    firmware: firmware || device.firmware,
+    telemetry: telemetry || device.telemetry
   };
 }
 
@@ -223,20 +237,10 @@ export async function getAllDevices(env: Env): Promise<DeviceInfo[]> {
 }
 
 /**
- * Set identify flag for device
+ * Set identify flag for device (queued as an identify command as well)
  */
 export async function setDeviceIdentifyFlag(deviceId: string, env: Env): Promise<boolean> {
-  const device = await getDevice(deviceId, env);
-  if (!device) {
-    throw new DeviceNotFoundError(deviceId);
-  }
-  
-  const updatedDevice = {
-    ...device,
-    identifyFlag: true
-  };
-  
-  await saveDevice(updatedDevice, env);
+  await queueDeviceCommand(deviceId, 'identify', undefined, env);
   return true;
 }
 
@@ -258,6 +262,172 @@ export async function clearDeviceIdentifyFlag(deviceId: string, env: Env): Promi
   return true;
 }
 
+/**
+ * Long-poll limits (GET /api/v1/devices/{deviceId}/commands?wait=N). KV is
+ * checked every few seconds while the request is held open.
+ */
+export const DEVICE_POLL = {
+  maxWaitSeconds: 25,     // Well inside proxy/idle-connection timeouts
+  checkIntervalMs: 5000   // ~5 KV reads per held request
+};
+
+/**
+ * Device command limits. Pending commands coalesce per type (the newer one
+ * wins), so a device never has more than one of each - the firmware keeps up
+ * to REGION_MAX_COMMANDS (4) per response.
+ */
+export const DEVICE_COMMANDS = {
+  types: ['identify', 'region', 'interval', 'refresh'] as DeviceCommandType[],
+  maxIntervalSeconds: 65535   // The firmware keeps the poll hint as uint16
+};
+
+/**
+ * Queue a command on a device record (the caller saves it). Region and
+ * interval commands change the stored assignment too, so the device's next
+ * poll is served the new config; identify also sets the flag older firmware
+ * reads. IDs start from the Unix time in seconds, so a re-created device
+ * record never reuses IDs the firmware has already applied.
+ */
+export function enqueueDeviceCommand(
+  device: DeviceInfo,
+  type: DeviceCommandType,
+  value?: string | number
+): { device: DeviceInfo; command: DeviceCommand } {
+  const command: DeviceCommand = {
+    id: Math.max((device.lastCommandId ?? 0) + 1, Math.floor(Date.now() / 1000)),
+    type,
+    queuedAt: new Date().toISOString()
+  };
+  const updatedDevice: DeviceInfo = {
+    ...device,
+    lastCommandId: command.id
+  };
+  
+  switch (type) {
+    case 'identify':
+      updatedDevice.identifyFlag = true;
+      break;
+    case 'region':
+      if (typeof value !== 'string' || !getRegion(value)) {
+        throw new InvalidDeviceCommandError(`Unknown region: ${value}`);
+      }
+      command.value = value;
+      updatedDevice.regionId = value;
+      break;
+    case 'interval':
+      if (typeof value !== 'number' || !Number.isInteger(value) || value < 0 ||
+          value > DEVICE_COMMANDS.maxIntervalSeconds) {
+        throw new InvalidDeviceCommandError(
+          `Interval must be 0 (regional schedule) to ${DEVICE_COMMANDS.maxIntervalSeconds} seconds`
+        );
+      }
+      command.value = value;
+      if (value === 0) {
+        delete updatedDevice.pollIntervalSeconds;
+      } else {
+        updatedDevice.pollIntervalSeconds = value;
+      }
+      break;
+    case 'refresh':
+      break;
+    default:
+      throw new InvalidDeviceCommandError(`Unknown command type: ${type}`);
+  }
+  
+  updatedDevice.commands = [
+    ...(device.commands ?? []).filter(pending => pending.type !== type),
+    command
+  ];
+  return { device: updatedDevice, command };
+}
+
+/**
+ * Queue a command for a stored device
+ */
+export async function queueDeviceCommand(
+  deviceId: string,
+  type: DeviceCommandType,
+  value: string | number | undefined,
+  env: Env
+): Promise<DeviceCommand> {
+  const device = await getDevice(deviceId, env);
+  if (!device) {
+    throw new DeviceNotFoundError(deviceId);
+  }
+  
+  const queued = enqueueDeviceCommand(device, type, value);
+  await saveDevice(queued.device, env);
+  console.log(`[INFO] Command ${queued.command.id} (${type}) queued for device: ${deviceId}`);
+  return queued.command;
+}
+
+/**
+ * Last command ID the firmware applied (X-Command-Ack). null for firmware
+ * without command support - those devices are never sent commands.
+ */
+export function parseCommandAck(request: Request): number | null {
+  const header = request.headers.get('X-Command-Ack');
+  if (header === null) {
+    return null;
+  }
+  const ack = Number(header);
+  return Number.isInteger(ack) && ack >= 0 ? ack : null;
+}
+
+/**
+ * Drop the commands an acknowledgement covers (same record when nothing changes)
+ */
+export function acknowledgeDeviceCommands(device: DeviceInfo, ack: number | null): DeviceInfo {
+  if (ack === null || !device.commands?.length) {
+    return device;
+  }
+  const pending = device.commands.filter(command => command.id > ack);
+  if (pending.length === device.commands.length) {
+    return device;
+  }
+  return { ...device, commands: pending };
+}
+
+/**
+ * Wait until the device has unacknowledged commands or waitMs passes. The
+ * identify flag is cleared with a delivered identify command so the next
+ * region response doesn't repeat it. Returns null when the device does not exist.
+ */
+export async function waitForDeviceCommands(
+  deviceId: string,
+  env: Env,
+  waitMs: number,
+  ack: number | null
+): Promise<DeviceCommand[] | null> {
+  const deadline = Date.now() + waitMs;
+  
+  for (;;) {
+    const device = await getDevice(deviceId, env);
+    if (!device) {
+      return null;
+    }
+    
+    let updatedDevice = acknowledgeDeviceCommands(device, ack);
+    const pending = updatedDevice.commands ?? [];
+    if (pending.length > 0 && updatedDevice.identifyFlag &&
+        pending.some(command => command.type === 'identify')) {
+      updatedDevice = { ...updatedDevice, identifyFlag: false };
+    }
+    if (updatedDevice !== device) {
+      await saveDevice(updatedDevice, env);
+    }
+    
+    if (pending.length > 0) {
+      return pending;
+    }
+    
+    if (Date.now() + DEVICE_POLL.checkIntervalMs > deadline) {
+      return [];
+    }
+    await new Promise(resolve => setTimeout(resolve, DEVICE_POLL.checkIntervalMs));
+  }
+}
+
 /**
  * Extract client IP address from request
  */
@@ -289,10 +459,151 @@ export function extractDeviceInfo(request: Request): {
   userAgent?: string;
   firmware?: string;
   ipAddress: string;
+  telemetry?: DeviceTelemetry;
 } {
   return {
     userAgent: request.headers.get('User-Agent') || undefined,
     firmware: request.headers.get('X-Firmware-Version') || undefined,
-    ipAddress: getClientIP(request)
+    ipAddress: getClientIP(request),
+    telemetry: parseTelemetryHeader(request.headers.get('X-Device-Telemetry'))
+  };
+}
+
+/**
+ * Firmware phase profiler order (ProfilePhase in weather-display-integrated.ino)
+ */
+export const TELEMETRY_PHASES = [
+  'boot', 'wifi', 'dns', 'tls', 'http', 'parse', 'render', 'panel', 'heartbeat', 'sleep'
+] as const;
+
+/**
+ * Parse a slash-separated phase list ("ph=120/850/...") into named phase values
+ */
+function parsePhaseList(
+  rawValue: string,
+  convert: (value: number) => number = value => value
+): Record<string, number> | undefined {
+  return namePhases(rawValue.split('/').map(Number), convert);
+}
+
+function namePhases(
+  values: number[],
+  convert: (value: number) => number = value => value
+): Record<string, number> | undefined {
+  if (values.some(value => !Number.isFinite(value))) {
+    return undefined;
+  }
+  
+  const phases: Record<string, number> = {};
+  TELEMETRY_PHASES.forEach((name, index) => {
+    if (index < values.length) {
+      phases[name] = convert(values[index]);
+    }
+  });
+  return phases;
+}
+
+/**
+ * Firmware charge figures are integer tenths of mA·s
+ */
+function toChargeMas(tenths: number): number {
+  return Math.round(tenths) / 10;
+}
+
+/**
+ * Parse the compact X-Device-Telemetry header ("key=value;key=value")
+ * Unknown keys and non-numeric values are ignored
+ */
+export function parseTelemetryHeader(header: string | null): DeviceTelemetry | undefined {
+  if (!header) {
+    return undefined;
+  }
+  
+  const fieldMap: Record<string, keyof Omit<DeviceTelemetry, 'reportedAt' | 'phasesMs' | 'phasesAvgMs' | 'chargeMas' | 'chargeSource'>> = {
+    rssi: 'rssi',
+    heap: 'freeHeap',
+    up: 'uptimeMs',
+    cyc: 'cycle',
+    awake: 'awakeMs',
+    bat: 'batteryMv',
+    pm: 'powerMode'
   };
+  
+  const telemetry: DeviceTelemetry = { reportedAt: new Date().toISOString() };
+  
+  for (const pair of header.split(';')) {
+    const [key, rawValue] = pair.split('=').map(part => part.trim());
+    
+    if ((key === 'ph' || key === 'pa') && rawValue) {
+      const phases = parsePhaseList(rawValue);
+      if (phases) {
+        telemetry[key === 'ph' ? 'phasesMs' : 'phasesAvgMs'] = phases;
+      }
+      continue;
+    }
+    
+    // Energy profiler: per-phase (q) and cycle (qc, qa) charge in tenths of mA·s
+    if (key === 'q' && rawValue) {
+      const charges = parsePhaseList(rawValue, toChargeMas);
+      if (charges) {
+        telemetry.chargeMas = charges;
+      }
+      continue;
+    }
+    if ((key === 'qc' || key === 'qa') && rawValue && Number.isFinite(Number(rawValue))) {
+      telemetry[key === 'qc' ? 'cycleChargeMas' : 'cycleChargeAvgMas'] = toChargeMas(Number(rawValue));
+      continue;
+    }
+    if (key === 'qs') {
+      telemetry.chargeSource = rawValue === '1' ? 'shunt' : 'model';
+      continue;
+    }
+    
+    const field = fieldMap[key];
+    const value = Number(rawValue);
+    if (field && rawValue !== undefined && Number.isFinite(value)) {
+      telemetry[field] = value;
+    }
+  }
+  
+  return telemetry;
+}
+
+/**
+ * Parse the energy trace a heartbeat body carries ("trace": [{cyc, src, ms, q, qw, qz}])
+ * qw/qz are awake and sleep charge - not the qa/qs of X-Device-Telemetry
+ * Malformed cycles are dropped; undefined when nothing usable is left
+ */
+export function parseEnergyTrace(body: unknown, firmware?: string): EnergyTrace | undefined {
+  const raw = (body as { trace?: unknown } | null)?.trace;
+  if (!Array.isArray(raw)) {
+    return undefined;
+  }
+  
+  const cycles: EnergyTraceCycle[] = [];
+  for (const entry of raw) {
+    const { cyc, src, ms, q, qw, qz } = (entry || {}) as Record<string, unknown>;
+    if (typeof cyc !== 'number' || typeof qw !== 'number' || typeof qz !== 'number' ||
+        !Array.isArray(ms) || !Array.isArray(q)) {
+      continue;
+    }
+    const phasesMs = namePhases(ms.map(Number));
+    const chargeMas = namePhases(q.map(Number), toChargeMas);
+    if (!phasesMs || !chargeMas) {
+      continue;
+    }
+    cycles.push({
+      cycle: cyc,
+      source: src === 1 ? 'shunt' : 'model',
+      phasesMs,
+      chargeMas,
+      awakeChargeMas: toChargeMas(qw),
+      sleepChargeMas: toChargeMas(qz),
+      totalChargeMas: toChargeMas(qw + qz)
+    });
+  }
+  
+  return cycles.length > 0
+    ? { reportedAt: new Date().toISOString(), firmware, cycles }
+    : undefined;
 }
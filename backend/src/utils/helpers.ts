@@ -1,3 +1,6 @@
+import { RegionConfig } from '../types/devices.js';
+import { POLL_SCHEDULE } from '../config/regions.js';
+
 /**
  * Convert knots to meters per second
  */
@@ -137,6 +140,29 @@ export async function generateContentHash(content: string): Promise<string> {
   return hashHex.substring(0, 16); // First 16 chars for cache key
 }
 
+/**
+ * Next-poll hint for a device: its own override if set, otherwise the regional
+ * day/night schedule in the region's local time
+ */
+export function computeNextPollSeconds(
+  region: RegionConfig,
+  pollOverrideSeconds?: number,
+  now: Date = new Date()
+): number {
+  if (pollOverrideSeconds) {
+    return Math.min(Math.max(Math.round(pollOverrideSeconds), POLL_SCHEDULE.minSeconds), POLL_SCHEDULE.maxSeconds);
+  }
+  
+  const localHour = Number(new Intl.DateTimeFormat('en-GB', {
+    hour: 'numeric',
+    hourCycle: 'h23',
+    timeZone: region.timezone
+  }).format(now));
+  
+  const night = localHour >= POLL_SCHEDULE.nightStartHour || localHour < POLL_SCHEDULE.nightEndHour;
+  return night ? POLL_SCHEDULE.nightSeconds : POLL_SCHEDULE.daySeconds;
+}
+
 /**
  * Create a cache key for weather data
  */
@@ -0,0 +1,219 @@
+/**
+ * Compact Binary Region Payload
+ * Weather Display System - device path for GET /api/v1/weather/region/{region}?format=bin
+ *
+ * Fixed little-endian layout, decoded by the firmware without heap allocation
+ * (see parseRegionBinary() in firmware/weather-display-integrated/weather_model.cpp):
+ *
+ *   Header (28 bytes)
+ *     0  char[2]   magic "WB"
+ *     2  uint8     version (1)
+ *     3  uint8     flags (bit 0 = identify, bit 1 = command block follows the stations,
+ *                  bit 2 = delta stations)
+ *     4  uint8     station count (delta: changed station count)
+ *     5  uint8     reserved
+ *     6  uint16    year of the response timestamp (UTC)
+ *     8  uint8     month (1-12)
+ *     9  uint8     day (1-31)
+ *     10 char[16]  regionId, NUL padded
+ *     26 uint16    reserved
+ *
+ *   Station (32 bytes each, in display order)
+ *     0  char[16]  stationId, NUL padded
+ *     16 uint16    wind avg, tenths of m/s
+ *     18 uint16    wind gust, tenths of m/s (0xFFFF = none)
+ *     20 int16     wind direction, degrees (-1 = none)
+ *     22 int16     air temperature, tenths of °C (0x7FFF = none)
+ *     24 char[6]   observation time "HH:MM" UTC, NUL terminated ("" = unknown)
+ *     30 uint16    reserved
+ *
+ *   Delta station (flags bit 2, &delta=1 against the version in If-None-Match)
+ *     0  uint8     display slot
+ *     1  uint8     changed fields (bit 0 stationId, 1 wind avg, 2 wind gust,
+ *                  3 wind direction, 4 air temperature, 5 observation time)
+ *     2  ...       the changed fields only, in bit order, each encoded as in a
+ *                  full station; a new stationId brings every field
+ *
+ *   Command block (flags bit 1; also the whole ?format=bin command long-poll body)
+ *     0  uint8     command count
+ *     1  uint8[3]  reserved
+ *     then 28 bytes per command, oldest first:
+ *     0  uint32    command ID
+ *     4  uint8     type (1 identify, 2 region, 3 interval, 4 refresh)
+ *     5  uint8[3]  reserved
+ *     8  uint32    numeric value (interval seconds)
+ *     12 char[16]  text value (regionId), NUL padded
+ */
+
+import { RegionWeatherResponse } from '../types/weather.js';
+import { DeviceCommand, DeviceCommandType } from '../types/devices.js';
+
+export const REGION_BINARY_CONTENT_TYPE = 'application/octet-stream';
+export const REGION_BINARY_VERSION = 1;
+export const REGION_BINARY_HEADER_SIZE = 28;
+export const REGION_BINARY_STATION_SIZE = 32;
+export const REGION_BINARY_FLAG_IDENTIFY = 0x01;
+export const REGION_BINARY_FLAG_COMMANDS = 0x02;
+export const REGION_BINARY_FLAG_DELTA = 0x04;
+export const REGION_BINARY_COMMANDS_HEADER_SIZE = 4;
+export const REGION_BINARY_COMMAND_SIZE = 28;
+
+// Station record fields in delta-mask bit order
+const DELTA_FIELDS = [
+  { offset: 0, length: 16 },  // stationId
+  { offset: 16, length: 2 },  // wind avg
+  { offset: 18, length: 2 },  // wind gust
+  { offset: 20, length: 2 },  // wind direction
+  { offset: 22, length: 2 },  // air temperature
+  { offset: 24, length: 6 }   // observation time
+];
+const DELTA_STATION_ID = 0x01;
+const DELTA_ALL_FIELDS = (1 << DELTA_FIELDS.length) - 1;
+
+const COMMAND_TYPE_CODES: Record<DeviceCommandType, number> = {
+  identify: 1,
+  region: 2,
+  interval: 3,
+  refresh: 4
+};
+
+const GUST_NONE = 0xffff;
+const DIRECTION_NONE = -1;
+const TEMPERATURE_NONE = 0x7fff;
+
+/**
+ * Write an ASCII string into a fixed NUL-padded field (truncated to fit)
+ */
+function writeFixedString(bytes: Uint8Array, offset: number, length: number, value: string): void {
+  for (let i = 0; i < length - 1 && i < value.length; i++) {
+    bytes[offset + i] = value.charCodeAt(i) & 0x7f;
+  }
+}
+
+/**
+ * Quantize m/s to tenths, clamped to the uint16 range below the "none" marker
+ */
+function quantizeSpeed(mps: number): number {
+  return Math.min(Math.max(Math.round(mps * 10), 0), GUST_NONE - 1);
+}
+
+/**
+ * Encode a region response into the compact device layout
+ */
+export function encodeRegionBinary(region: RegionWeatherResponse, identify: boolean): Uint8Array {
+  const stationCount = Math.min(region.stations.length, 255);
+  const bytes = new Uint8Array(REGION_BINARY_HEADER_SIZE + stationCount * REGION_BINARY_STATION_SIZE);
+  const view = new DataView(bytes.buffer);
+  const timestamp = new Date(region.timestamp);
+
+  bytes[0] = 'W'.charCodeAt(0);
+  bytes[1] = 'B'.charCodeAt(0);
+  view.setUint8(2, REGION_BINARY_VERSION);
+  view.setUint8(3, identify ? REGION_BINARY_FLAG_IDENTIFY : 0);
+  view.setUint8(4, stationCount);
+  view.setUint16(6, timestamp.getUTCFullYear(), true);
+  view.setUint8(8, timestamp.getUTCMonth() + 1);
+  view.setUint8(9, timestamp.getUTCDate());
+  writeFixedString(bytes, 10, 16, region.regionId);
+
+  for (let i = 0; i < stationCount; i++) {
+    const station = region.stations[i];
+    const offset = REGION_BINARY_HEADER_SIZE + i * REGION_BINARY_STATION_SIZE;
+    const wind = station.data.wind;
+    const air = station.data.temperature?.air;
+
+    writeFixedString(bytes, offset, 16, station.stationId);
+    view.setUint16(offset + 16, quantizeSpeed(wind.avg), true);
+    view.setUint16(offset + 18, wind.gust === undefined || wind.gust === null ? GUST_NONE : quantizeSpeed(wind.gust), true);
+    view.setInt16(offset + 20, wind.direction === null ? DIRECTION_NONE : Math.round(wind.direction) % 360, true);
+    view.setInt16(offset + 22, air === undefined || air === null ? TEMPERATURE_NONE : Math.max(Math.min(Math.round(air * 10), 32000), -32000), true);
+
+    // Same HH:MM slice the firmware takes from the ISO timestamp
+    if (station.timestamp && station.timestamp.length >= 16) {
+      writeFixedString(bytes, offset + 24, 6, station.timestamp.substring(11, 16));
+    }
+  }
+
+  return bytes;
+}
+
+function rangesEqual(a: Uint8Array, b: Uint8Array, offset: number, length: number): boolean {
+  for (let i = offset; i < offset + length; i++) {
+    if (a[i] !== b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Changes from one encoded region (what the device holds) to another, in the
+ * delta layout - compared on the wire encoding, so a field counts as changed
+ * exactly when the device would decode something different. null when the
+ * station count differs (send the full payload).
+ */
+export function encodeRegionDelta(base: Uint8Array, current: Uint8Array): Uint8Array | null {
+  const stationCount = current[4];
+  if (base.length < REGION_BINARY_HEADER_SIZE || base[4] !== stationCount ||
+      base.length < REGION_BINARY_HEADER_SIZE + stationCount * REGION_BINARY_STATION_SIZE) {
+    return null;
+  }
+
+  const records: number[] = [];
+  let changedStations = 0;
+  for (let i = 0; i < stationCount; i++) {
+    const offset = REGION_BINARY_HEADER_SIZE + i * REGION_BINARY_STATION_SIZE;
+    let changed = 0;
+    DELTA_FIELDS.forEach((field, bit) => {
+      if (!rangesEqual(base, current, offset + field.offset, field.length)) {
+        changed |= 1 << bit;
+      }
+    });
+    if (changed & DELTA_STATION_ID) {
+      changed = DELTA_ALL_FIELDS;
+    }
+    if (!changed) {
+      continue;
+    }
+
+    records.push(i, changed);
+    DELTA_FIELDS.forEach((field, bit) => {
+      if (changed & (1 << bit)) {
+        records.push(...current.subarray(offset + field.offset, offset + field.offset + field.length));
+      }
+    });
+    changedStations++;
+  }
+
+  const bytes = new Uint8Array(REGION_BINARY_HEADER_SIZE + records.length);
+  bytes.set(current.subarray(0, REGION_BINARY_HEADER_SIZE));
+  bytes[3] |= REGION_BINARY_FLAG_DELTA;
+  bytes[4] = changedStations;
+  bytes.set(records, REGION_BINARY_HEADER_SIZE);
+  return bytes;
+}
+
+/**
+ * Encode pending device commands as a command block
+ */
+export function encodeCommandBlock(commands: DeviceCommand[]): Uint8Array {
+  const commandCount = Math.min(commands.length, 255);
+  const bytes = new Uint8Array(REGION_BINARY_COMMANDS_HEADER_SIZE + commandCount * REGION_BINARY_COMMAND_SIZE);
+  const view = new DataView(bytes.buffer);
+
+  view.setUint8(0, commandCount);
+  for (let i = 0; i < commandCount; i++) {
+    const command = commands[i];
+    const offset = REGION_BINARY_COMMANDS_HEADER_SIZE + i * REGION_BINARY_COMMAND_SIZE;
+
+    view.setUint32(offset, command.id, true);
+    view.setUint8(offset + 4, COMMAND_TYPE_CODES[command.type] ?? 0);
+    if (typeof command.value === 'number') {
+      view.setUint32(offset + 8, command.value, true);
+    } else if (typeof command.value === 'string') {
+      writeFixedString(bytes, offset + 12, 16, command.value);
+    }
+  }
+
+  return bytes;
+}
@@ -0,0 +1,221 @@
+/**
+ * Precomputed Region Payloads
+ * Weather Display System - device-facing region responses built once per upstream update
+ *
+ * The cron trigger assembles each region's response from the station cache
+ * right after collection and stores it in KV under a content version. Device
+ * polls read that one entry (edge-cached by KV) and answer from it: no station
+ * fan-out, no per-request hashing or binary encoding. A missing entry (cold
+ * KV, stalled cron) is rebuilt on the request path and stored for the rest.
+ */
+
+import { RegionWeatherResponse, WeatherResponse, Env } from '../types/weather.js';
+import { DeviceCommand, RegionConfig } from '../types/devices.js';
+import { generateContentHash } from './helpers.js';
+import {
+  encodeCommandBlock,
+  encodeRegionBinary,
+  encodeRegionDelta,
+  REGION_BINARY_FLAG_COMMANDS,
+  REGION_BINARY_FLAG_IDENTIFY
+} from './regionBinary.js';
+
+export interface RegionPayload {
+  version: string;                  // Content hash of what devices render (ETag base)
+  builtAt: string;                  // ISO timestamp of the build
+  response: RegionWeatherResponse;
+  binary: string;                   // encodeRegionBinary(response, false), base64
+}
+
+export type RegionStationLoader = (stationId: string) => Promise<WeatherResponse & { error?: string }>;
+
+const REGION_PAYLOAD_KEY_PREFIX = 'region-payload:';
+const REGION_PAYLOAD_TTL_SECONDS = 900;       // Outlives several missed cron runs, then rebuilt on request
+const REGION_PAYLOAD_REFRESH_SECONDS = 450;   // Rewrite an unchanged payload this old so it never expires under load
+const REGION_PAYLOAD_EDGE_TTL_SECONDS = 60;   // KV edge cache per location (the minimum KV allows)
+
+// Binary body of each stored version, the base for delta responses
+const REGION_SNAPSHOT_KEY_PREFIX = 'region-snapshot:';
+const REGION_SNAPSHOT_TTL_SECONDS = 7200;     // Outlives the longest device sleep (1 hour)
+const REGION_SNAPSHOT_EDGE_TTL_SECONDS = 3600; // A version's snapshot never changes
+
+function regionPayloadKey(regionId: string): string {
+  return `${REGION_PAYLOAD_KEY_PREFIX}${regionId}`;
+}
+
+function regionSnapshotKey(regionId: string, version: string): string {
+  return `${REGION_SNAPSHOT_KEY_PREFIX}${regionId}:${version}`;
+}
+
+function decodeBase64(data: string): Uint8Array {
+  return Uint8Array.from(atob(data), c => c.charCodeAt(0));
+}
+
+/**
+ * Content version of a region: station data and the date devices show.
+ * Envelope and placeholder timestamps are left out so an unchanged region
+ * keeps its version (and devices keep getting 304 Not Modified).
+ */
+export async function generateRegionVersion(
+  regionId: string,
+  stations: Array<WeatherResponse & { error?: string }>,
+  timestamp: string
+): Promise<string> {
+  const content = JSON.stringify({
+    regionId,
+    date: timestamp.substring(0, 10),
+    stations: stations.map(station => ({
+      stationId: station.stationId,
+      timestamp: station.error ? null : station.timestamp,
+      data: station.data,
+      error: station.error || null
+    }))
+  });
+  return generateContentHash(content);
+}
+
+/**
+ * ETag for one device response: the payload version plus what varies per
+ * request (format, identify flag). Kept within the firmware's 24-byte slot.
+ */
+export function regionPayloadETag(payload: RegionPayload, identify: boolean, format: 'json' | 'bin'): string {
+  return `"${payload.version}-${format === 'bin' ? 'b' : 'j'}${identify ? 'i' : ''}"`;
+}
+
+/**
+ * Payload version of a binary ETag the device sent (If-None-Match), if any
+ */
+export function regionPayloadETagVersion(etag: string | null): string | null {
+  const match = etag?.match(/^"([0-9a-f]{16})-b/);
+  return match ? match[1] : null;
+}
+
+/**
+ * Binary body for one device - the stored encoding, or its changes against
+ * the base version's body when one is given, with the identify flag set and
+ * the device's pending commands appended
+ */
+export function regionPayloadBinary(
+  payload: RegionPayload,
+  identify: boolean,
+  commands: DeviceCommand[] = [],
+  base: string | null = null
+): { bytes: Uint8Array; delta: boolean } {
+  const stored = decodeBase64(payload.binary);
+  const delta = base ? encodeRegionDelta(decodeBase64(base), stored) : null;
+  const stations = delta ?? stored;
+  const block = commands.length > 0 ? encodeCommandBlock(commands) : new Uint8Array(0);
+  const bytes = new Uint8Array(stations.length + block.length);
+  bytes.set(stations);
+  bytes.set(block, stations.length);
+  if (identify) {
+    bytes[3] |= REGION_BINARY_FLAG_IDENTIFY;
+  }
+  if (block.length > 0) {
+    bytes[3] |= REGION_BINARY_FLAG_COMMANDS;
+  }
+  return { bytes, delta: delta !== null };
+}
+
+/**
+ * Assemble a region's payload in display order
+ */
+export async function buildRegionPayload(
+  region: RegionConfig,
+  loadStation: RegionStationLoader
+): Promise<RegionPayload> {
+  const stations = await Promise.all(region.stations.map(stationId => loadStation(stationId)));
+  const builtAt = new Date().toISOString();
+
+  const response: RegionWeatherResponse = {
+    schema: "weather-region.v1",
+    regionId: region.name,
+    regionName: region.displayName,
+    timestamp: builtAt,
+    stations,
+    ttl: 300 // 5 minutes
+  };
+
+  const binary = encodeRegionBinary(response, false);
+  return {
+    version: await generateRegionVersion(region.name, stations, builtAt),
+    builtAt,
+    response,
+    binary: btoa(String.fromCharCode(...binary))
+  };
+}
+
+export async function getStoredRegionPayload(regionId: string, env: Env): Promise<RegionPayload | null> {
+  return await env.WEATHER_CACHE.get(regionPayloadKey(regionId), {
+    type: 'json',
+    cacheTtl: REGION_PAYLOAD_EDGE_TTL_SECONDS
+  }) as RegionPayload | null;
+}
+
+export async function storeRegionPayload(payload: RegionPayload, env: Env): Promise<void> {
+  await Promise.all([
+    env.WEATHER_CACHE.put(regionPayloadKey(payload.response.regionId), JSON.stringify(payload), {
+      expirationTtl: REGION_PAYLOAD_TTL_SECONDS
+    }),
+    env.WEATHER_CACHE.put(regionSnapshotKey(payload.response.regionId, payload.version), payload.binary, {
+      expirationTtl: REGION_SNAPSHOT_TTL_SECONDS
+    })
+  ]);
+}
+
+/**
+ * Binary body (base64) of an earlier version, null once it has expired
+ */
+export async function getRegionSnapshot(regionId: string, version: string, env: Env): Promise<string | null> {
+  return await env.WEATHER_CACHE.get(regionSnapshotKey(regionId, version), {
+    cacheTtl: REGION_SNAPSHOT_EDGE_TTL_SECONDS
+  });
+}
+
+/**
+ * Request path: the stored payload, or one built now (stored in the background)
+ */
+export async function getRegionPayload(
+  region: RegionConfig,
+  env: Env,
+  ctx: ExecutionContext,
+  loadStation: RegionStationLoader
+): Promise<{ payload: RegionPayload; cacheHit: boolean }> {
+  const stored = await getStoredRegionPayload(region.name, env);
+  if (stored) {
+    return { payload: stored, cacheHit: true };
+  }
+
+  const payload = await buildRegionPayload(region, loadStation);
+  ctx.waitUntil(storeRegionPayload(payload, env));
+  return { payload, cacheHit: false };
+}
+
+/**
+ * Cron path: rebuild every region after station collection. Skips the KV
+ * write while the content is unchanged and the stored copy is still fresh
+ * (uncached read - the edge copy may be a minute old).
+ */
+export async function precomputeRegionPayloads(
+  regions: RegionConfig[],
+  env: Env,
+  loadStation: RegionStationLoader
+): Promise<void> {
+  for (const region of regions) {
+    try {
+      const payload = await buildRegionPayload(region, loadStation);
+      const stored = await env.WEATHER_CACHE.get(regionPayloadKey(region.name), { type: 'json' }) as RegionPayload | null;
+      const storedAgeSeconds = stored ? (Date.now() - new Date(stored.builtAt).getTime()) / 1000 : Infinity;
+
+      if (stored && stored.version === payload.version && storedAgeSeconds < REGION_PAYLOAD_REFRESH_SECONDS) {
+        console.log(`[INFO] Region payload unchanged for ${region.name} (${payload.version})`);
+        continue;
+      }
+
+      await storeRegionPayload(payload, env);
+      console.log(`[INFO] Region payload stored for ${region.name} (${payload.version})`);
+    } catch (error) {
+      console.error(`[ERROR] Failed to precompute region payload for ${region.name}:`, error);
+    }
+  }
+}
@@ -0,0 +1,115 @@
+/**
+ * Station Fetch Orchestrator
+ * Weather Display System - concurrent upstream collection with per-source deadlines
+ *
+ * Every station of a request (or cron run) is collected at once. A source that
+ * misses its deadline is answered from its last good reading, marked stale,
+ * while the fetch keeps running in the background (ctx.waitUntil) and refreshes
+ * the caches for the next build - stale-while-revalidate. A slow station host
+ * bounds nothing but its own freshness.
+ */
+
+import { WeatherResponse, Env } from '../types/weather.js';
+
+export type StationReading = WeatherResponse & { error?: string };
+export type StationCollector = (stationId: string, env: Env) => Promise<WeatherResponse | null>;
+
+/**
+ * Per-source deadlines: sources needing several upstream round trips get more
+ */
+export const STATION_FETCH_DEADLINES_MS: Record<string, number> = {
+  seaview: 6000,    // Session page plus historical or live data request
+  lymington: 5000,  // Enhanced API with current-data fallback
+  default: 4000
+};
+
+const LAST_GOOD_KEY_PREFIX = 'last-good:';
+const LAST_GOOD_TTL_SECONDS = 3600; // Older readings are not worth showing as a fallback
+
+const DEADLINE_MISSED = Symbol('deadline-missed');
+
+function lastGoodKey(stationId: string): string {
+  return `${LAST_GOOD_KEY_PREFIX}${stationId}`;
+}
+
+/**
+ * Keep a reading as the station's fallback (called on every successful collection)
+ */
+export async function storeLastGoodReading(reading: WeatherResponse, env: Env): Promise<void> {
+  await env.WEATHER_CACHE.put(lastGoodKey(reading.stationId), JSON.stringify(reading), {
+    expirationTtl: LAST_GOOD_TTL_SECONDS
+  });
+}
+
+export async function getLastGoodReading(stationId: string, env: Env): Promise<WeatherResponse | null> {
+  return await env.WEATHER_CACHE.get(lastGoodKey(stationId), { type: 'json' }) as WeatherResponse | null;
+}
+
+/**
+ * Seconds since a reading was collected
+ */
+export function readingAgeSeconds(reading: WeatherResponse, now: number = Date.now()): number {
+  return Math.max(0, Math.round((now - new Date(reading.timestamp).getTime()) / 1000));
+}
+
+/**
+ * One station within its deadline: fresh, else its last good reading (stale),
+ * else null. The fetch is never abandoned - it completes under waitUntil.
+ */
+export async function fetchStationWithDeadline(
+  stationId: string,
+  env: Env,
+  ctx: ExecutionContext,
+  collect: StationCollector
+): Promise<StationReading | null> {
+  const deadlineMs = STATION_FETCH_DEADLINES_MS[stationId] ?? STATION_FETCH_DEADLINES_MS.default;
+  const collection = collect(stationId, env).catch(error => {
+    console.error(`[ERROR] Collection failed for ${stationId}:`, error);
+    return null;
+  });
+  ctx.waitUntil(collection);
+
+  let timer: ReturnType<typeof setTimeout> | undefined;
+  const deadline = new Promise<typeof DEADLINE_MISSED>(resolve => {
+    timer = setTimeout(() => resolve(DEADLINE_MISSED), deadlineMs);
+  });
+  const result = await Promise.race([collection, deadline]);
+  clearTimeout(timer);
+
+  if (result !== DEADLINE_MISSED && result) {
+    return result;
+  }
+
+  if (result === DEADLINE_MISSED) {
+    console.warn(`[WARN] ${stationId} missed its ${deadlineMs}ms deadline, revalidating in the background`);
+  }
+  const lastGood = await getLastGoodReading(stationId, env);
+  if (lastGood) {
+    console.log(`[INFO] Serving last good ${stationId} reading (${readingAgeSeconds(lastGood)}s old)`);
+    return { ...lastGood, stale: true };
+  }
+  return null;
+}
+
+/**
+ * Many stations concurrently - the slowest source costs at most its deadline.
+ * Stations with neither a fresh nor a last good reading are left out.
+ */
+export async function fetchStations(
+  stationIds: string[],
+  env: Env,
+  ctx: ExecutionContext,
+  collect: StationCollector
+): Promise<Map<string, StationReading>> {
+  const readings = await Promise.all(
+    stationIds.map(stationId => fetchStationWithDeadline(stationId, env, ctx, collect))
+  );
+
+  const byStation = new Map<string, StationReading>();
+  readings.forEach((reading, index) => {
+    if (reading) {
+      byStation.set(stationIds[index], reading);
+    }
+  });
+  return byStation;
+}
@@ -0,0 +1,391 @@
+/**
+ * Host Benchmark v2.2.0
+ * Weather Display Integrated - parse and render off-device
+ *
+ * Replays region payloads (binary "WB" or JSON, as served by
+ * GET /api/v1/weather/region/{region}) through the sketch's own parse and
+ * layout modules against a mock 800x480 1-bpp sprite, and reports per payload:
+ *
+ *   parse      time per parse (median / min over the iterations)
+ *   render     full frame (clear + static layer + values + footer), the
+ *              cached path a normal refresh takes (static layer copy + values)
+ *              and the incremental path of a one-field change (that field, the
+ *              station's wind trend and the footer redrawn over the previous
+ *              frame, checked pixel for pixel against a full render)
+ *   heap       allocations and peak live bytes of one steady-state cycle
+ *              (parse + cached render + footer), plus the first cycle, which
+ *              reserves the static layer block
+ *
+ * Usage: bench [-n iterations] [--pbm prefix] [--stations n] payload...
+ * --stations repeats the parsed stations into n slots, to measure the grid
+ * layouts with the captured three-station payloads.
+ * Exits non-zero when a payload fails to parse or an incremental frame differs,
+ * so it doubles as a smoke check.
+ */
+
+#include <malloc.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <new>
+#include <vector>
+
+#include "frame_buffer.h"
+#include "weather_layout.h"
+#include "weather_model.h"
+#ifndef BENCH_JSON
+  #define BENCH_JSON 0
+#endif
+#if BENCH_JSON
+  #include "region_json.h"
+#endif
+
+#define BENCH_DISPLAY_WIDTH 800
+#define BENCH_DISPLAY_HEIGHT 480
+#define BENCH_DEFAULT_ITERATIONS 2000
+
+// ===============================================================================
+// ALLOCATION TRACKING (-Wl,--wrap=malloc,... plus operator new/delete below)
+// ===============================================================================
+
+struct HeapStats {
+  size_t allocations = 0;
+  size_t liveBytes = 0;
+  size_t peakBytes = 0;
+};
+static HeapStats heap;
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+void __real_free(void* ptr);
+
+static void trackAlloc(void* ptr) {
+  if (!ptr) return;
+  heap.allocations++;
+  heap.liveBytes += malloc_usable_size(ptr);
+  heap.peakBytes = std::max(heap.peakBytes, heap.liveBytes);
+}
+
+static void trackFree(void* ptr) {
+  if (ptr) heap.liveBytes -= malloc_usable_size(ptr);
+}
+
+void* __wrap_malloc(size_t size) {
+  void* ptr = __real_malloc(size);
+  trackAlloc(ptr);
+  return ptr;
+}
+
+void* __wrap_calloc(size_t count, size_t size) {
+  void* ptr = __real_calloc(count, size);
+  trackAlloc(ptr);
+  return ptr;
+}
+
+void* __wrap_realloc(void* ptr, size_t size) {
+  size_t before = ptr ? malloc_usable_size(ptr) : 0;
+  void* moved = __real_realloc(ptr, size);
+  if (moved) {
+    heap.liveBytes -= before;
+    trackAlloc(moved);
+  }
+  return moved;
+}
+
+void __wrap_free(void* ptr) {
+  trackFree(ptr);
+  __real_free(ptr);
+}
+}
+
+void* operator new(size_t size) {
+  void* ptr = malloc(size ? size : 1);
+  if (!ptr) throw std::bad_alloc();
+  return ptr;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void operator delete(void* ptr) noexcept { free(ptr); }
+void operator delete[](void* ptr) noexcept { free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
+// Counters for the code between begin and end only; peak is relative to the start
+static HeapStats heapBegin() {
+  HeapStats start = heap;
+  heap.allocations = 0;
+  heap.peakBytes = heap.liveBytes;
+  return start;
+}
+
+static HeapStats heapEnd(const HeapStats& start) {
+  HeapStats used = {heap.allocations, heap.liveBytes - start.liveBytes, heap.peakBytes - start.liveBytes};
+  heap.allocations += start.allocations;
+  heap.peakBytes = std::max(heap.peakBytes, start.peakBytes);
+  return used;
+}
+
+// ===============================================================================
+// PAYLOADS
+// ===============================================================================
+
+struct Payload {
+  const char* path;
+  std::vector<char> bytes; // NUL terminated for the JSON reader
+  bool binary;
+};
+
+static bool loadPayload(const char* path, Payload& payload) {
+  FILE* file = fopen(path, "rb");
+  if (!file) {
+    fprintf(stderr, "%s: cannot open\n", path);
+    return false;
+  }
+  char chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    payload.bytes.insert(payload.bytes.end(), chunk, chunk + n);
+  }
+  fclose(file);
+
+  payload.path = path;
+  payload.binary = payload.bytes.size() >= 2 && payload.bytes[0] == 'W' && payload.bytes[1] == 'B';
+  payload.bytes.push_back('\0');
+  return true;
+}
+
+// One parse as the sketch does it: filtered document or fixed offsets into the model
+static bool parsePayload(const Payload& payload, RegionHeader& header, StationData* stations) {
+  memset(stations, 0, sizeof(StationData) * STATION_SLOTS);
+  if (payload.binary) {
+    return parseRegionBinary((const uint8_t*)payload.bytes.data(), payload.bytes.size() - 1, header, stations);
+  }
+#if BENCH_JSON
+  StaticJsonDocument<REGION_JSON_DOC_SIZE> doc;
+  const char* json = payload.bytes.data();
+  if (readRegionJson(json, doc)) return false;
+  regionJsonHash(doc); // Computed every cycle for the unchanged-payload check
+  return parseRegionJson(doc, header, stations);
+#else
+  return false;
+#endif
+}
+
+// Fill slots up to count by repeating the parsed stations
+static void padStations(StationData* stations, int count) {
+  int parsed = 0;
+  while (parsed < STATION_SLOTS && stations[parsed].stationName[0] != '\0') parsed++;
+  for (int i = parsed; parsed > 0 && i < count && i < STATION_SLOTS; i++) {
+    stations[i] = stations[i % parsed];
+  }
+}
+
+// Two hours of wind trend per station around its parsed reading, with a gap
+// where the unit slept through a few buckets
+static void fillHistory(StationHistory* history, const StationData* stations) {
+  memset(history, 0, sizeof(StationHistory) * STATION_SLOTS);
+  for (int i = 0; i < STATION_SLOTS; i++) {
+    StationData sample = stations[i];
+    for (int bucket = 1; bucket <= HISTORY_SAMPLES; bucket++) {
+      if (bucket > 20 && bucket <= 23) continue;
+      int swing = (bucket * 7 + i * 13) % 21 - 10; // -1.0..+1.0 m/s
+      sample.windSpeed = std::max(0, stations[i].windSpeed + swing * (bucket % 5 + 1));
+      sample.windGust = stations[i].windGust == VALUE_MISSING ? VALUE_MISSING
+                                                              : sample.windSpeed + 20 + (bucket % 3) * 10;
+      sample.windDirection = (stations[i].windDirection + bucket * 4 + 360) % 360;
+      recordWindHistory(history[i], sample, bucket);
+    }
+  }
+}
+
+// ===============================================================================
+// RENDERING
+// ===============================================================================
+
+static void renderFooter(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations) {
+  char updated[24];
+  snprintf(updated, sizeof(updated), "Updated: %.11s", stations[0].lastUpdateTime);
+  FooterStatus status = {updated, 3, "Bat:87%", "ID:a1b2c3", ""};
+  drawStatusFooter(sprite, frame, status);
+}
+
+static void renderFull(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                       const StationHistory* history) {
+  frame.fillScreen(TFT_WHITE);
+  drawStaticLayer(frame, stations);
+  drawValueLayer(sprite, frame, stations, history);
+  renderFooter(sprite, frame, stations);
+}
+
+static void renderCached(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                         const StationHistory* history) {
+  drawWeatherData(sprite, frame, stations, history);
+  renderFooter(sprite, frame, stations);
+}
+
+static void renderChanged(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                          const StationHistory* history, uint32_t changedFields, uint32_t changedTrends) {
+  if (!drawChangedFields(sprite, frame, stations, history, changedFields, changedTrends)) {
+    drawWeatherData(sprite, frame, stations, history);
+  }
+  renderFooter(sprite, frame, stations);
+}
+
+// Incremental frame equals the full render of the same data (restores the
+// previous frame's state to the full one, so the PBM output is unaffected)
+static bool incrementalMatches(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                               const StationHistory* history) {
+  size_t length = (size_t)(sprite.width() + 7) / 8 * sprite.height();
+  std::vector<uint8_t> incremental((uint8_t*)sprite.getPointer(), (uint8_t*)sprite.getPointer() + length);
+  renderFull(sprite, frame, stations, history);
+  return memcmp(incremental.data(), sprite.getPointer(), length) == 0;
+}
+
+// P4 bitmap (1 = black, the inverse of the sprite's bits)
+static void writePbm(const char* path, TFT_eSprite& sprite) {
+  FILE* file = fopen(path, "wb");
+  if (!file) return;
+  fprintf(file, "P4\n%d %d\n", sprite.width(), sprite.height());
+  const uint8_t* bytes = (const uint8_t*)sprite.getPointer();
+  size_t length = (size_t)(sprite.width() + 7) / 8 * sprite.height();
+  for (size_t i = 0; i < length; i++) fputc(~bytes[i] & 0xFF, file);
+  fclose(file);
+}
+
+// ===============================================================================
+// TIMING
+// ===============================================================================
+
+// Median microseconds per run (and the fastest run, when asked)
+template <typename TFunction>
+static double timeRuns(int iterations, double* minUs, TFunction run) {
+  std::vector<double> samples;
+  samples.reserve(iterations);
+  for (int i = 0; i < iterations; i++) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto end = std::chrono::steady_clock::now();
+    samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  if (minUs) *minUs = samples.front();
+  return samples[samples.size() / 2];
+}
+
+static int usage() {
+  fprintf(stderr, "usage: bench [-n iterations] [--pbm prefix] [--stations n] payload...\n");
+  return 2;
+}
+
+int main(int argc, char** argv) {
+  int iterations = BENCH_DEFAULT_ITERATIONS;
+  const char* pbmPrefix = NULL;
+  int stationCount = 0; // As parsed
+  std::vector<const char*> paths;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      iterations = std::max(1, atoi(argv[++i]));
+    } else if (strcmp(argv[i], "--pbm") == 0 && i + 1 < argc) {
+      pbmPrefix = argv[++i];
+    } else if (strcmp(argv[i], "--stations") == 0 && i + 1 < argc) {
+      stationCount = atoi(argv[++i]);
+    } else if (argv[i][0] == '-') {
+      return usage();
+    } else {
+      paths.push_back(argv[i]);
+    }
+  }
+  if (paths.empty()) return usage();
+
+  TFT_eSprite sprite(BENCH_DISPLAY_WIDTH, BENCH_DISPLAY_HEIGHT);
+  FrameBuffer frame;
+  frame.attach(&sprite);
+
+  printf("Host benchmark: %d iterations, frame buffer %s, JSON %s\n", iterations,
+         frame.direct() ? "direct 1-bpp" : "sprite primitives", BENCH_JSON ? "on" : "off (no ArduinoJson)");
+  printf("%-28s %9s %9s %9s %9s %9s %7s %8s %7s %8s %7s\n", "payload", "parse", "min",
+         "full", "cached", "changed", "allocs", "peak B", "first", "first B", "layout");
+
+  int failures = 0;
+  for (const char* path : paths) {
+    Payload payload;
+    if (!loadPayload(path, payload)) {
+      failures++;
+      continue;
+    }
+    if (!payload.binary && !BENCH_JSON) {
+      printf("%-28s skipped - JSON payload, built without ArduinoJson\n", path);
+      continue;
+    }
+
+    RegionHeader header;
+    StationData stations[STATION_SLOTS];
+    StationHistory history[STATION_SLOTS];
+
+    // First cycle from the cold cache - includes the static layer reservation
+    HeapStats start = heapBegin();
+    bool parsed = parsePayload(payload, header, stations);
+    padStations(stations, stationCount);
+    fillHistory(history, stations);
+    if (parsed) renderCached(sprite, frame, stations, history);
+    HeapStats first = heapEnd(start);
+    if (!parsed) {
+      printf("%-28s PARSE FAILED\n", path);
+      failures++;
+      continue;
+    }
+
+    start = heapBegin();
+    parsePayload(payload, header, stations);
+    padStations(stations, stationCount);
+    renderCached(sprite, frame, stations, history);
+    HeapStats steady = heapEnd(start);
+
+    double parseMinUs;
+    double parseUs = timeRuns(iterations, &parseMinUs, [&] { parsePayload(payload, header, stations); });
+    padStations(stations, stationCount);
+    double fullUs = timeRuns(iterations, NULL, [&] { renderFull(sprite, frame, stations, history); });
+    double cachedUs = timeRuns(iterations, NULL, [&] { renderCached(sprite, frame, stations, history); });
+
+    // First station's gust toggling between a value and none ("--" - a different
+    // width, so the check holds with the placeholder glyphs too), one field and
+    // the trend (one bucket on) per refresh
+    StationData changed[STATION_SLOTS];
+    StationHistory changedHistory[STATION_SLOTS];
+    memcpy(changed, stations, sizeof(changed));
+    memcpy(changedHistory, history, sizeof(changedHistory));
+    changed[0].windGust = (stations[0].windGust == VALUE_MISSING) ? 50 : VALUE_MISSING;
+    recordWindHistory(changedHistory[0], changed[0], HISTORY_SAMPLES + 1);
+    uint32_t gustField = 1UL << FIELD_WIND_GUST; // Slot 0
+    uint32_t trend = 1UL << 0;
+    bool toggled = false;
+    renderCached(sprite, frame, stations, history);
+    double changedUs = timeRuns(iterations, NULL, [&] {
+      toggled = !toggled;
+      renderChanged(sprite, frame, toggled ? changed : stations, toggled ? changedHistory : history,
+                    gustField, trend);
+    });
+    if (!incrementalMatches(sprite, frame, toggled ? changed : stations, toggled ? changedHistory : history)) {
+      printf("%-28s INCREMENTAL FRAME MISMATCH\n", path);
+      failures++;
+      continue;
+    }
+    renderCached(sprite, frame, stations, history);
+
+    printf("%-28s %7.1fus %7.1fus %7.1fus %7.1fus %7.1fus %7zu %8zu %7zu %8zu %7s\n", path,
+           parseUs, parseMinUs, fullUs, cachedUs, changedUs, steady.allocations, steady.peakBytes,
+           first.allocations, first.peakBytes, stationLayoutFor(stations).name);
+
+    if (pbmPrefix) {
+      const char* base = strrchr(path, '/');
+      char out[512];
+      snprintf(out, sizeof(out), "%s%s.pbm", pbmPrefix, base ? base + 1 : path);
+      writePbm(out, sprite);
+    }
+  }
+  return failures ? 1 : 0;
+}
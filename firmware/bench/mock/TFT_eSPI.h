@@ -0,0 +1,147 @@
+/**
+ * Host Mock of TFT_eSPI / Seeed_GFX v2.2.0
+ * Weather Display Integrated - host benchmark
+ *
+ * Just enough of TFT_eSprite for FrameBuffer and weather_layout: an 800x480
+ * 1-bpp buffer in the library's bit order (MSB first, 1 = TFT_WHITE) and the
+ * sprite primitives the layout calls directly. Built-in bitmap font text is
+ * drawn as 5x7 cells, so footer timings are indicative only.
+ *
+ * GFX free fonts come from Seeed_GFX when the Makefile finds it (BENCH_GFX_FONTS),
+ * otherwise from mock_fonts.cpp - same metrics family, placeholder glyphs.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+using std::max;
+using std::min;
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+
+#define TFT_BLACK 0x0000
+#define TFT_WHITE 0xFFFF
+#define TL_DATUM 0
+
+typedef struct {
+  uint16_t bitmapOffset;
+  uint8_t width;
+  uint8_t height;
+  uint8_t xAdvance;
+  int8_t xOffset;
+  int8_t yOffset;
+} GFXglyph;
+
+typedef struct {
+  uint8_t* bitmap;
+  GFXglyph* glyph;
+  uint16_t first;
+  uint16_t last;
+  uint8_t yAdvance;
+} GFXfont;
+
+#if BENCH_GFX_FONTS
+  #include <Fonts/GFXFF/FreeSans12pt7b.h>
+  #include <Fonts/GFXFF/FreeSansBold18pt7b.h>
+#else
+  extern const GFXfont FreeSans12pt7b;
+  extern const GFXfont FreeSansBold18pt7b;
+#endif
+
+class TFT_eSprite {
+public:
+  TFT_eSprite(int16_t width, int16_t height)
+    : _width(width), _height(height), _stride((width + 7) / 8), _textSize(1) {
+    _buffer = (uint8_t*)calloc(_stride * height, 1);
+  }
+  ~TFT_eSprite() { free(_buffer); }
+
+  uint8_t getColorDepth() const { return 1; }
+  uint8_t getRotation() const { return 0; }
+  void* getPointer() { return _buffer; }
+  int16_t width() const { return _width; }
+  int16_t height() const { return _height; }
+
+  void drawPixel(int32_t x, int32_t y, uint32_t color) {
+    if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+    uint8_t* cell = _buffer + y * _stride + (x >> 3);
+    uint8_t bit = 0x80 >> (x & 7);
+    *cell = color ? (*cell | bit) : (*cell & ~bit);
+  }
+
+  void fillScreen(uint32_t color) { fillRect(0, 0, _width, _height, color); }
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    for (int32_t row = y; row < y + h; row++) {
+      for (int32_t col = x; col < x + w; col++) drawPixel(col, row, color);
+    }
+  }
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint32_t color) { fillRect(x, y, w, 1, color); }
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint32_t color) { fillRect(x, y, 1, h, color); }
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint32_t color) {
+    drawFastHLine(x, y, w, color);
+    drawFastHLine(x, y + h - 1, w, color);
+    drawFastVLine(x, y, h, color);
+    drawFastVLine(x + w - 1, y, h, color);
+  }
+
+  // Bresenham, as TFT_eSPI drawLine()
+  void drawLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1, uint32_t color) {
+    int32_t dx = abs(x1 - x0), dy = -abs(y1 - y0);
+    int32_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+    int32_t err = dx + dy;
+    for (;;) {
+      drawPixel(x0, y0, color);
+      if (x0 == x1 && y0 == y1) break;
+      int32_t e2 = 2 * err;
+      if (e2 >= dy) { err += dy; x0 += sx; }
+      if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+  }
+
+  // Midpoint circle outline, as TFT_eSPI drawCircle()
+  void drawCircle(int32_t x0, int32_t y0, int32_t r, uint32_t color) {
+    int32_t x = r, y = 0, err = 1 - r;
+    while (x >= y) {
+      drawPixel(x0 + x, y0 + y, color); drawPixel(x0 - x, y0 + y, color);
+      drawPixel(x0 + x, y0 - y, color); drawPixel(x0 - x, y0 - y, color);
+      drawPixel(x0 + y, y0 + x, color); drawPixel(x0 - y, y0 + x, color);
+      drawPixel(x0 + y, y0 - x, color); drawPixel(x0 - y, y0 - x, color);
+      y++;
+      if (err < 0) {
+        err += 2 * y + 1;
+      } else {
+        x--;
+        err += 2 * (y - x) + 1;
+      }
+    }
+  }
+
+  void setFreeFont(const GFXfont* font = NULL) { _font = font; }
+  void setTextSize(uint8_t size) { _textSize = size ? size : 1; }
+  void setTextColor(uint16_t color) { _textColor = color; }
+  void setTextDatum(uint8_t datum) { (void)datum; }
+
+  // Built-in font only (FrameBuffer draws GFX text itself): 6x8 cells per character
+  int16_t drawString(const char* text, int32_t x, int32_t y) {
+    int32_t cursor = x;
+    for (const char* c = text; *c; c++, cursor += 6 * _textSize) {
+      if (*c != ' ') fillRect(cursor, y, 5 * _textSize, 7 * _textSize, _textColor);
+    }
+    return cursor - x;
+  }
+
+private:
+  uint8_t* _buffer;
+  int16_t _width;
+  int16_t _height;
+  int32_t _stride;
+  const GFXfont* _font = NULL;
+  uint8_t _textSize;
+  uint16_t _textColor = TFT_BLACK;
+};
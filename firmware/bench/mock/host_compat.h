@@ -0,0 +1,23 @@
+/**
+ * Host Compatibility Shims v2.2.0
+ * Weather Display Integrated - host benchmark
+ *
+ * Force-included into every host translation unit (-include): libc functions
+ * newlib provides on the ESP32 that glibc before 2.38 does not.
+ */
+
+#pragma once
+
+#include <string.h>
+
+#if defined(__GLIBC__) && !(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 38))
+static inline size_t strlcpy(char* dst, const char* src, size_t size) {
+  size_t length = strlen(src);
+  if (size > 0) {
+    size_t copy = length < size - 1 ? length : size - 1;
+    memcpy(dst, src, copy);
+    dst[copy] = '\0';
+  }
+  return length;
+}
+#endif
@@ -0,0 +1,46 @@
+/**
+ * Placeholder GFX Fonts v2.2.0
+ * Weather Display Integrated - host benchmark
+ *
+ * Stand-ins for FreeSans12pt7b and FreeSansBold18pt7b when Seeed_GFX is not
+ * installed: printable ASCII, glyph boxes close to the real fonts' average
+ * size, each glyph a hollow box so blit timings see realistic bit density.
+ * Layout widths and timings are approximate - point SEEED_GFX_DIR at the real
+ * library for pixel-exact frames.
+ */
+
+#include "TFT_eSPI.h"
+
+#define MOCK_FONT_FIRST 0x20
+#define MOCK_FONT_LAST 0x7E
+#define MOCK_FONT_GLYPHS (MOCK_FONT_LAST - MOCK_FONT_FIRST + 1)
+
+struct MockFont {
+  uint8_t bitmap[MOCK_FONT_GLYPHS * 80];
+  GFXglyph glyphs[MOCK_FONT_GLYPHS];
+
+  MockFont(uint8_t width, uint8_t height, uint8_t advance) {
+    uint32_t bit = 0;
+    memset(bitmap, 0, sizeof(bitmap));
+    for (int i = 0; i < MOCK_FONT_GLYPHS; i++) {
+      bool space = (i + MOCK_FONT_FIRST) == ' ';
+      uint8_t w = space ? 0 : width;
+      uint8_t h = space ? 0 : height;
+      glyphs[i] = {(uint16_t)(bit >> 3), w, h, (uint8_t)(space ? advance / 2 : advance), 1, (int8_t)-height};
+
+      for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++, bit++) {
+          bool edge = x < 2 || y < 2 || x >= w - 2 || y >= h - 2;
+          if (edge) bitmap[bit >> 3] |= 0x80 >> (bit & 7);
+        }
+      }
+      bit = (bit + 7) & ~7U; // Each glyph starts on a byte, as in the fontconvert output
+    }
+  }
+};
+
+static MockFont sans12(11, 17, 13);
+static MockFont sansBold18(17, 25, 20);
+
+extern const GFXfont FreeSans12pt7b = {sans12.bitmap, sans12.glyphs, MOCK_FONT_FIRST, MOCK_FONT_LAST, 29};
+extern const GFXfont FreeSansBold18pt7b = {sansBold18.bitmap, sansBold18.glyphs, MOCK_FONT_FIRST, MOCK_FONT_LAST, 42};
@@ -15,29 +15,123 @@
 // Update Intervals (milliseconds) - v2.1.0 Power Optimized
 #define WEATHER_UPDATE_INTERVAL 180000    // 3 minutes - combines all operations
 #define HEARTBEAT_INTERVAL 180000         // 3 minutes - combined with weather update
+#define HEARTBEAT_IN_WEATHER_REQUEST 1    // v2.2.0: Send telemetry with the weather GET, no separate POST
 #define WIFI_CHECK_INTERVAL 180000        // 3 minutes - combined with weather update
 #define SLEEP_BETWEEN_UPDATES 1           // Enable ESP32 deep sleep between updates
 #define MINIMUM_SLEEP_TIME 30000          // Minimum sleep time (30 seconds)
 #define DEEP_SLEEP_ENABLED 1              // Enable ESP32 deep sleep (0 to disable)
+#define PIPELINED_CYCLE 1                 // v2.2.0: Refresh panel in a task while network work continues
+#define DISPLAY_TASK_STACK 8192           // v2.2.0: Display task stack (bytes)
+#define DISPLAY_REFRESH_TIMEOUT 30000     // v2.2.0: Display task wait before warning (the wait itself continues)
 
 // Display Settings - Enhanced Visual Hierarchy v2.1.4
-#define FULL_REFRESH_ALWAYS 1             // Always use full refresh for perfect quality
-#define FLASH_CLEAR_CYCLES 1              // Minimal: Just 1 flash for fastest updates
+#define FULL_REFRESH_ALWAYS 0             // v2.2.0: 1 = disable partial refresh entirely
+#define PARTIAL_REFRESH_ENABLED 1         // v2.2.0: Push only dirty regions via UC8179 partial window
+#define FULL_REFRESH_EVERY_N_CYCLES 10    // v2.2.0: Full refresh every N panel refreshes (ghosting control)
+#define PARTIAL_REFRESH_MAX_RECTS 12      // v2.2.0: More dirty regions than this -> full refresh (all merged into one partial window)
 #define ANTI_GHOST_DELAY 100              // Minimal delay for fastest response
+#define ANTI_GHOST_CLEAN_INTERVAL 30      // v2.2.0: Single-pass clean every 30 panel refreshes
+#define ANTI_GHOST_CLEAN_INTERVAL_COLD 10 // v2.2.0: ...every 10 when the panel is cold
+#define ANTI_GHOST_COLD_THRESHOLD 5.0     // v2.2.0: Cold below 5°C (chip temperature)
 #define IDENTIFY_FLASH_COUNT 3            // Number of flashes for identify
 #define IDENTIFY_FLASH_DELAY 500          // Delay between identify flashes (ms)
+#define DISPLAY_CHANGED_ONLY 1            // v2.2.0: Skip refresh when rendered content is unchanged
+#define DISPLAY_MAX_STALENESS 1800000     // v2.2.0: Force a refresh at least every 30 minutes
+#define STATIC_LAYER_CACHE 1              // v2.2.0: Keep names/labels/rules in a 48 KB heap block, redraw values only
+#define TREND_HISTORY 1                   // v2.2.0: Wind trend sparkline per station from RTC-kept samples
+#define HISTORY_BUCKET_MS 180000          // v2.2.0: One trend sample per 3 minutes (HISTORY_SAMPLES in weather_model.h)
 
 // Regional Configuration v2.0.0
 #define DEFAULT_REGION "chamonix"          // Default region assignment
-#define CHAMONIX_DISPLAY_UNIT "kph"       // Alpine stations: km/h
-#define SOLENT_DISPLAY_UNIT "kts"         // Marine stations: knots
+// v2.2.0: Per-region display units live in regions_generated.h (generated from the backend config)
 #define ENABLE_REGIONAL_UNITS 1           // Enable unit conversion for display
 
 // Network Retry Settings
-#define MAX_HTTP_RETRIES 3
-#define HTTP_RETRY_DELAY 1000             // 1 second between retries
+#define MAX_HTTP_RETRIES 3                // v2.2.0: Attempts per cycle for connection errors and 5xx
+#define HTTP_RETRY_DELAY 1000             // v2.2.0: First in-cycle retry after ~1 second, doubling
 #define MAX_WIFI_RECONNECT_ATTEMPTS 5     // WiFi reconnection attempts
 
+// Retry Policy v2.2.0 - per-cycle radio budget, backoff across sleeps
+#define RADIO_BUDGET_PER_CYCLE 20000      // WiFi connect plus requests give up after 20 seconds of radio time
+#define WIFI_SCAN_CONNECT_TIMEOUT 10000   // Per matching network after a scan (driver.h WIFI_CONNECT_TIMEOUT is 30s)
+#define HTTP_CONNECT_TIMEOUT 4000         // TCP connect (replaces the global HTTP_TIMEOUT)...
+#define HTTP_READ_TIMEOUT 6000            // ...and response read; TLS keeps TLS_HANDSHAKE_TIMEOUT
+#define RETRY_BACKOFF_MAX 3600000         // Failed cycles retry at the normal interval, doubling up to 1 hour while the AP or backend is down
+#define RETRY_JITTER_PERCENT 20           // +/-20% on every backoff delay
+
+// WiFi Fast Connect v2.2.0 - reuse cached BSSID/channel/lease from RTC memory
+#define WIFI_FAST_CONNECT 1               // Skip the scan when the last AP is cached
+#define WIFI_FAST_CONNECT_TIMEOUT 3000    // Give up on the cached AP after 3 seconds
+#define WIFI_REUSE_DHCP_LEASE 1           // Reuse last DHCP lease (skips DHCP round trip)
+#define WIFI_POLL_INTERVAL 50             // WiFi status polling step (ms)
+
+// TLS Session Resumption v2.2.0 - session ticket/ID and backend IP kept in RTC memory
+#define TLS_SESSION_RESUMPTION 1          // Abbreviated handshake on warm wakes
+#define TLS_HANDSHAKE_TIMEOUT 10000       // Give up on a TLS handshake after 10 seconds
+#define TLS_VERIFY_SERVER 1               // Verify the backend certificate against BACKEND_ROOT_CA (secrets.h); 0 = unauthenticated, testing only
+
+// Phase Profiler v2.2.0
+#define PROFILE_RING_SIZE 8               // Completed cycles kept in RTC memory for telemetry
+
+// Energy Profiler v2.2.0 - charge per phase (mA·s) alongside the phase times
+// Modelled from time in each phase unless a test rig samples the supply current.
+#define ENERGY_MODEL_PHASE_MA {45, 95, 80, 90, 80, 40, 35, 30, 85, 25} // Supply current per ProfilePhase (boot..sleep)
+#define ENERGY_MODEL_IDLE_MA 25           // Awake outside any phase (loop waits, backoff)
+#define ENERGY_DEEP_SLEEP_UA 45           // Board + sleeping panel in deep sleep
+#define ENERGY_SHUNT 0                    // Test rigs: current-sense amplifier across a supply shunt into ENERGY_SHUNT_ADC_PIN
+#define ENERGY_SHUNT_ADC_PIN A2           // Must be an ADC1 pin (ADC2 is unusable with WiFi on the C3)
+#define ENERGY_SHUNT_MILLIOHM 1000        // Shunt resistance
+#define ENERGY_SHUNT_GAIN 20              // Amplifier gain (INA180A1)
+#define ENERGY_SAMPLE_INTERVAL_US 5000    // 200 Hz; the sampling timer keeps the CPU out of light sleep
+#define ENERGY_SAMPLE_RING 4096           // Samples kept for per-phase charge (~20 s); older spans fall back to the model
+#define ENERGY_TRACE_UPLOAD 0             // POST the whole RTC trace with a heartbeat each time the ring fills
+
+// Adaptive Scheduler v2.2.0 - WEATHER_UPDATE_INTERVAL (or the backend's X-Next-Poll hint) is the base
+#define ADAPTIVE_SCHEDULE 1
+#define SCHEDULE_MIN_INTERVAL 120000      // Never poll faster than 2 minutes
+#define SCHEDULE_MAX_INTERVAL 3600000     // Never sleep longer than 1 hour
+#define SCHEDULE_ACTIVE_INTERVAL 120000   // Poll interval while the wind is changing fast or gusting
+#define SCHEDULE_UNCHANGED_STRETCH 50     // +50% of the base interval per unchanged cycle...
+#define SCHEDULE_MAX_STRETCH_STEPS 6      // ...up to 6 cycles (4x the base)
+#define SCHEDULE_WIND_DELTA 20            // Average wind change that counts as fast (tenths of m/s)
+#define SCHEDULE_GUST_THRESHOLD 100       // Gusts from 10 m/s (~19 kts) count as active (tenths of m/s)
+
+// Battery Monitor v2.2.0 - XIAO ESP32C3 has no on-board sense: fit 2x 220k from BAT+ to A0
+#define BATTERY_MONITOR 1
+#define BATTERY_ADC_PIN A0
+#define BATTERY_DIVIDER_RATIO 2.0         // BAT+ voltage per ADC pin voltage
+#define BATTERY_SAMPLES 16                // ADC readings averaged per wake
+#define BATTERY_PRESENT_MV 2500           // Below this no battery is sensed (USB power) - stay in normal mode
+#define BATTERY_FULL_MV 4200              // Footer percentage range (LiPo)
+#define BATTERY_EMPTY_MV 3300
+#define BATTERY_CONSERVE_MV 3600          // Conserve mode below 3.6V...
+#define BATTERY_CRITICAL_MV 3400          // ...critical (low-battery frame, long sleep) below 3.4V
+#define BATTERY_HYSTERESIS_MV 50          // Recover only this far above a threshold
+#define CONSERVE_INTERVAL_FACTOR 3        // Conserve: update interval x3 (up to SCHEDULE_MAX_INTERVAL)
+#define CONSERVE_HEARTBEAT_EVERY 5        // Conserve: telemetry every 5th cycle
+#define CRITICAL_SLEEP_TIME 21600000ULL   // Critical: re-check the battery every 6 hours
+
+// Power Profile v2.2.0 - CPU clock and modem power per cycle phase
+#define POWER_PROFILE 1
+#define CPU_FREQ_FULL_MHZ 160             // TLS handshake and payload parsing
+#define CPU_FREQ_IDLE_MHZ 80              // Everything else (lowest clock WiFi runs at)
+#define MODEM_SLEEP_AFTER_HTTP 1          // Max modem sleep once the last request of the cycle is done
+
+// Light-Sleep Loop v2.2.0 - units that stay awake (deep sleep off, or short waits)
+// Needs CONFIG_PM_ENABLE + tickless idle in the core build, else modem sleep only.
+// USB serial output stops while the CPU light-sleeps.
+#define LIGHT_SLEEP_LOOP 1
+#define LIGHT_SLEEP_MIN_FREQ_MHZ 40       // Clock floor between light sleeps (XTAL)
+#define LIGHT_SLEEP_IDLE_STEP 1000        // Plain idle wait per loop pass (ms)
+#define COMMAND_LONG_POLL 1               // Wait for backend commands (identify, region, interval, refresh) on a held request
+#define COMMAND_LONG_POLL_WAIT 25000      // Backend holds the request up to 25 seconds
+#define COMMAND_LONG_POLL_MIN_WAIT 5000   // Not worth a request when the cycle is this close
+#define COMMAND_LONG_POLL_MARGIN 5000     // HTTP timeout beyond the wait
+
+// Payload Format v2.2.0
+#define BINARY_REGION_PAYLOAD 1           // Request ?format=bin (falls back to JSON if the backend ignores it)
+#define REGION_DELTA_UPDATES 1            // Ask for changed station fields only (&delta=1, binary payload only)
+
 // Device Settings v2.1.8 - WiFi Signal Bars
 #define DEVICE_FIRMWARE_VERSION "2.1.8"
 #define DEVICE_USER_AGENT "WeatherDisplay/2.1.8 ESP32C3"
@@ -46,6 +140,8 @@
 #define ENABLE_HEAP_MONITORING 1
 #define HEAP_CHECK_INTERVAL 30000         // 30 seconds
 #define JSON_BUFFER_SIZE 4096             // Larger buffer for 3 stations
+#define REGION_JSON_DOC_SIZE 2560         // v2.2.0: Filtered region document (6 stations, fields the display uses, commands)
+#define REGION_JSON_FILTER_SIZE 384       // v2.2.0: Filter document for the region parse
 
 // v2.1.8 Backend Compatibility - WiFi Signal Bars
 #define API_VERSION "2.1.8"
@@ -55,5 +151,5 @@
 #define TEMPERATURE_RANGE_MAX 60.0
 
 // Error Recovery
-#define ERROR_RECOVERY_TIMEOUT 300000     // 5 minutes before showing error state
+#define ERROR_RECOVERY_TIMEOUT 300000     // v2.2.0: Failures keep last-known-good data (marked stale) this long before the error screen
 #define WIFI_RECOVERY_TIMEOUT 60000       // 1 minute WiFi recovery timeout
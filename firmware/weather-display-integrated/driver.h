@@ -37,6 +37,21 @@
   
   // Seeed_GFX already provides EPaper class in Extensions/EPaper.h
   
+  // v2.2.0: Windowed refresh for partial updates. EPaper::update(x, y, w, h) is
+  // only used when the installed Seeed_GFX declares it (detected at compile
+  // time); otherwise epaperUpdateWindow() returns false and the caller falls
+  // back to a full update()
+  template <typename Panel>
+  auto epaperUpdateWindow(Panel& panel, int x, int y, int w, int h, int)
+      -> decltype(panel.update(x, y, w, h), bool()) {
+    panel.update(x, y, w, h);
+    return true;
+  }
+  template <typename Panel>
+  bool epaperUpdateWindow(Panel&, int, int, int, int, long) {
+    return false;
+  }
+  
   // Display refresh settings
   #define USE_FULL_REFRESH true
   #define ANTI_GHOSTING_ENABLED true
@@ -0,0 +1,232 @@
+/**
+ * Packed 1-bpp Frame Buffer v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * See frame_buffer.h. Pixel convention matches TFT_eSprite at 1 bpp: any
+ * non-zero colour sets the bit (TFT_WHITE), zero clears it (TFT_BLACK).
+ */
+
+#include "frame_buffer.h"
+
+FrameBuffer::FrameBuffer()
+  : _sprite(NULL), _ascentFont(NULL), _ascent(0), _buffer(NULL), _width(0), _height(0), _stride(0) {
+}
+
+void FrameBuffer::attach(TFT_eSprite* sprite) {
+  _sprite = sprite;
+  _buffer = NULL;
+
+  if (sprite && sprite->getColorDepth() == 1 && sprite->getRotation() == 0 && sprite->getPointer()) {
+    _buffer = (uint8_t*)sprite->getPointer();
+    _width = sprite->width();
+    _height = sprite->height();
+    _stride = (_width + 7) >> 3;
+  }
+}
+
+// ===============================================================================
+// FILLS
+// ===============================================================================
+
+void FrameBuffer::fillScreen(uint16_t color) {
+  if (!_buffer) {
+    _sprite->fillScreen(color);
+    return;
+  }
+  memset(_buffer, color ? 0xFF : 0x00, _stride * _height);
+}
+
+void FrameBuffer::fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  if (!_buffer) {
+    _sprite->fillRect(x, y, w, h, color);
+    return;
+  }
+
+  int32_t x0 = max(x, (int32_t)0), x1 = min(x + w, _width);
+  int32_t y0 = max(y, (int32_t)0), y1 = min(y + h, _height);
+  for (int32_t row = y0; row < y1 && x0 < x1; row++) {
+    fillSpan(_buffer + row * _stride, x0, x1, color != 0);
+  }
+}
+
+void FrameBuffer::drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color) {
+  drawFastHLine(x, y, w, color);
+  drawFastHLine(x, y + h - 1, w, color);
+  drawFastVLine(x, y + 1, h - 2, color);
+  drawFastVLine(x + w - 1, y + 1, h - 2, color);
+}
+
+void FrameBuffer::drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color) {
+  fillRect(x, y, w, 1, color);
+}
+
+void FrameBuffer::drawFastVLine(int32_t x, int32_t y, int32_t h, uint16_t color) {
+  if (!_buffer) {
+    _sprite->drawFastVLine(x, y, h, color);
+    return;
+  }
+  for (int32_t row = y; row < y + h; row++) {
+    setPixel(x, row, color != 0);
+  }
+}
+
+// Bits [x0, x1) of one row: partial head/tail bytes, 32-bit words in between
+void FrameBuffer::fillSpan(uint8_t* row, int32_t x0, int32_t x1, bool set) {
+  int32_t first = x0 >> 3;
+  int32_t last = (x1 - 1) >> 3;
+  uint8_t head = 0xFF >> (x0 & 7);
+  uint8_t tail = 0xFF << (7 - ((x1 - 1) & 7));
+
+  if (first == last) {
+    uint8_t mask = head & tail;
+    row[first] = set ? (row[first] | mask) : (row[first] & ~mask);
+    return;
+  }
+
+  row[first] = set ? (row[first] | head) : (row[first] & ~head);
+  row[last] = set ? (row[last] | tail) : (row[last] & ~tail);
+
+  uint8_t fill = set ? 0xFF : 0x00;
+  int32_t i = first + 1;
+  while (i < last && ((uintptr_t)(row + i) & 3)) {
+    row[i++] = fill;
+  }
+  uint32_t word = set ? 0xFFFFFFFFUL : 0;
+  for (; i + 4 <= last; i += 4) {
+    *(uint32_t*)(row + i) = word;
+  }
+  while (i < last) {
+    row[i++] = fill;
+  }
+}
+
+void FrameBuffer::setPixel(int32_t x, int32_t y, bool set) {
+  if (x < 0 || y < 0 || x >= _width || y >= _height) return;
+  uint8_t* cell = _buffer + y * _stride + (x >> 3);
+  uint8_t bit = 0x80 >> (x & 7);
+  *cell = set ? (*cell | bit) : (*cell & ~bit);
+}
+
+// ===============================================================================
+// TEXT
+// ===============================================================================
+
+int16_t FrameBuffer::drawString(const GFXfont* font, const char* text, int32_t x, int32_t y, uint16_t color) {
+  if (!_buffer) {
+    _sprite->setFreeFont(font);
+    _sprite->setTextSize(1);
+    _sprite->setTextDatum(TL_DATUM);
+    _sprite->setTextColor(color);
+    _sprite->drawString(text, x, y);
+    return textAdvance(font, text);
+  }
+
+  // Top-left datum: TFT_eSPI puts the baseline at the font's tallest ascent
+  int32_t baseline = y + fontAscent(font);
+  uint8_t first = pgm_read_byte(&font->first);
+  uint8_t last = pgm_read_byte(&font->last);
+  int32_t cursor = x;
+
+  for (const char* c = text; *c; c++) {
+    uint8_t code = (uint8_t)*c;
+    if (code < first || code > last) continue;
+
+    const GFXglyph* glyph = &font->glyph[code - first];
+    drawGlyph(font, glyph, cursor, baseline, color != 0);
+    cursor += pgm_read_byte(&glyph->xAdvance);
+  }
+  return cursor - x;
+}
+
+// One glyph row at a time: gather the row's bits from the packed glyph bitmap,
+// then OR/AND them into the frame bytes they cover
+void FrameBuffer::drawGlyph(const GFXfont* font, const GFXglyph* glyph, int32_t x, int32_t baseline, bool set) {
+  const uint8_t* bitmap = font->bitmap + pgm_read_word(&glyph->bitmapOffset);
+  int32_t w = pgm_read_byte(&glyph->width);
+  int32_t h = pgm_read_byte(&glyph->height);
+  int32_t px = x + (int8_t)pgm_read_byte(&glyph->xOffset);
+  int32_t py = baseline + (int8_t)pgm_read_byte(&glyph->yOffset);
+  bool rowWise = (w <= 56) && px >= 0 && px + w <= _width;
+
+  for (int32_t yy = 0; yy < h; yy++) {
+    uint32_t bit = yy * w;
+    int32_t row = py + yy;
+    if (row < 0 || row >= _height) continue;
+
+    if (!rowWise) {
+      for (int32_t xx = 0; xx < w; xx++, bit++) {
+        if (pgm_read_byte(&bitmap[bit >> 3]) & (0x80 >> (bit & 7))) {
+          setPixel(px + xx, row, set);
+        }
+      }
+      continue;
+    }
+
+    uint64_t bits = 0;
+    for (int32_t got = 0; got < w;) {
+      uint32_t at = bit + got;
+      int32_t shift = at & 7;
+      int32_t take = min(8 - shift, w - got);
+      uint8_t chunk = (uint8_t)(pgm_read_byte(&bitmap[at >> 3]) << shift) >> (8 - take);
+      bits = (bits << take) | chunk;
+      got += take;
+    }
+    if (!bits) continue;
+
+    int32_t align = px & 7;
+    uint64_t aligned = bits << (64 - w - align); // Leftmost pixel at the top of the byte run
+    uint8_t* cell = _buffer + row * _stride + (px >> 3);
+    for (int32_t b = 0; b < (align + w + 7) >> 3; b++) {
+      uint8_t mask = (uint8_t)(aligned >> (56 - 8 * b));
+      cell[b] = set ? (cell[b] | mask) : (cell[b] & ~mask);
+    }
+  }
+}
+
+// Same ascent TFT_eSPI setFreeFont() computes (glyph_ab)
+int16_t FrameBuffer::fontAscent(const GFXfont* font) {
+  if (font != _ascentFont) {
+    uint8_t first = pgm_read_byte(&font->first);
+    uint8_t last = pgm_read_byte(&font->last);
+    _ascent = 0;
+    for (uint16_t c = 0; c < last - first; c++) {
+      int16_t above = -(int8_t)pgm_read_byte(&font->glyph[c].yOffset);
+      if (above > _ascent) _ascent = above;
+    }
+    _ascentFont = font;
+  }
+  return _ascent;
+}
+
+int16_t FrameBuffer::textAdvance(const GFXfont* font, const char* text) {
+  uint8_t first = pgm_read_byte(&font->first);
+  uint8_t last = pgm_read_byte(&font->last);
+  int16_t advance = 0;
+
+  for (const char* c = text; *c; c++) {
+    uint8_t code = (uint8_t)*c;
+    if (code >= first && code <= last) {
+      advance += pgm_read_byte(&font->glyph[code - first].xAdvance);
+    }
+  }
+  return advance;
+}
+
+int16_t FrameBuffer::textWidth(const GFXfont* font, const char* text) {
+  uint8_t first = pgm_read_byte(&font->first);
+  uint8_t last = pgm_read_byte(&font->last);
+  int16_t width = 0;
+
+  for (const char* c = text; *c; c++) {
+    uint8_t code = (uint8_t)*c;
+    if (code < first || code > last) continue;
+
+    const GFXglyph* glyph = &font->glyph[code - first];
+    if (c[1]) {
+      width += pgm_read_byte(&glyph->xAdvance);
+    } else {
+      width += (int8_t)pgm_read_byte(&glyph->xOffset) + pgm_read_byte(&glyph->width);
+    }
+  }
+  return width;
+}
@@ -0,0 +1,54 @@
+/**
+ * Packed 1-bpp Frame Buffer v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * Thin render backend over the ePaper sprite's own frame buffer (800x480 at
+ * 1 bpp, rows packed MSB first). Clears and rectangle fills are byte/word
+ * writes instead of per-pixel primitives, and GFX font glyphs are blitted a
+ * row at a time. epaper.update() still pushes the buffer to the controller.
+ *
+ * When the sprite is not a plain 1-bpp, unrotated buffer every call falls back
+ * to the sprite's own primitives, so the output is the same either way.
+ */
+
+#pragma once
+
+#include "TFT_eSPI.h"
+
+class FrameBuffer {
+public:
+  FrameBuffer();
+
+  // Direct access only for a 1-bpp sprite at rotation 0
+  void attach(TFT_eSprite* sprite);
+  bool direct() const { return _buffer != NULL; }
+
+  void fillScreen(uint16_t color);
+  void fillRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+  void drawRect(int32_t x, int32_t y, int32_t w, int32_t h, uint16_t color);
+  void drawFastHLine(int32_t x, int32_t y, int32_t w, uint16_t color);
+  void drawFastVLine(int32_t x, int32_t y, int32_t h, uint16_t color);
+
+  // Top-left datum, text size 1, transparent background - same pixels as
+  // TFT_eSPI drawString(). Returns the cursor advance.
+  int16_t drawString(const GFXfont* font, const char* text, int32_t x, int32_t y, uint16_t color);
+
+  // Cursor advance (sum of xAdvance) - where the next string continues
+  static int16_t textAdvance(const GFXfont* font, const char* text);
+  // TFT_eSPI textWidth(): the last glyph counts its ink width, not its advance
+  static int16_t textWidth(const GFXfont* font, const char* text);
+
+private:
+  void fillSpan(uint8_t* row, int32_t x0, int32_t x1, bool set);
+  void setPixel(int32_t x, int32_t y, bool set);
+  void drawGlyph(const GFXfont* font, const GFXglyph* glyph, int32_t x, int32_t baseline, bool set);
+  int16_t fontAscent(const GFXfont* font);
+
+  TFT_eSprite* _sprite;
+  const GFXfont* _ascentFont; // Font the cached ascent belongs to
+  int16_t _ascent;
+  uint8_t* _buffer;
+  int32_t _width;
+  int32_t _height;
+  int32_t _stride;      // Bytes per row
+};
@@ -0,0 +1,146 @@
+/**
+ * Region JSON Payload v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * See region_json.h.
+ */
+
+#include "region_json.h"
+#include <stdlib.h>
+#include <string.h>
+
+// ArduinoJson writer that FNV-1a hashes whatever is serialized into it
+class HashWriter {
+public:
+  uint32_t hash = 2166136261UL;
+  size_t write(uint8_t c) {
+    hash ^= c;
+    hash *= 16777619UL;
+    return 1;
+  }
+  size_t write(const uint8_t* buffer, size_t length) {
+    hash = fnv1aUpdate(hash, (const char*)buffer, length);
+    return length;
+  }
+};
+
+void buildRegionJsonFilter(JsonDocument& filter) {
+  filter["regionId"] = true;
+  filter["regionName"] = true;
+  filter["timestamp"] = true;
+  filter["identify"] = true;
+  JsonObject command = filter["commands"].createNestedObject();
+  command["id"] = true;
+  command["type"] = true;
+  command["value"] = true;
+  JsonObject station = filter["stations"].createNestedObject();
+  station["stationId"] = true;
+  station["timestamp"] = true;
+  station["data"]["wind"]["avg"] = true;
+  station["data"]["wind"]["gust"] = true;
+  station["data"]["wind"]["direction"] = true;
+  station["data"]["temperature"]["air"] = true;
+}
+
+uint32_t regionJsonHash(JsonDocument& doc) {
+  HashWriter hasher;
+  serializeJson(doc["regionId"], hasher);
+  serializeJson(doc["identify"], hasher);
+  serializeJson(doc["commands"], hasher);
+  serializeJson(doc["stations"], hasher);
+  const char* timestamp = doc["timestamp"] | "";
+  size_t dateLength = strlen(timestamp);
+  hasher.write((const uint8_t*)timestamp, dateLength < 10 ? dateLength : 10);
+  return hasher.hash;
+}
+
+bool regionJsonHasActions(JsonDocument& doc) {
+  return doc["identify"].as<bool>() || doc["commands"].as<JsonArrayConst>().size() > 0;
+}
+
+// Interval values arrive as numbers, region IDs as strings
+void parseCommandsJson(JsonArrayConst array, DeviceCommandList& commands) {
+  commands.count = 0;
+  for (JsonObjectConst entry : array) {
+    if (commands.count >= REGION_MAX_COMMANDS) break;
+    DeviceCommand& command = commands.items[commands.count++];
+    command.id = entry["id"].as<uint32_t>();
+    command.type = commandTypeFromName(entry["type"] | "");
+    command.value = entry["value"].is<const char*>() ? 0 : entry["value"].as<uint32_t>();
+    strlcpy(command.text, entry["value"].is<const char*>() ? entry["value"].as<const char*>() : "",
+            sizeof(command.text));
+  }
+}
+
+// New region weather response parser for 3-station data
+bool parseRegionJson(JsonDocument& doc, RegionHeader& header, StationData* stations) {
+  // Extract region info
+  strlcpy(header.regionId, doc["regionId"] | "", sizeof(header.regionId));
+  strlcpy(header.regionName, doc["regionName"] | "", sizeof(header.regionName));
+  header.identify = doc["identify"].as<bool>();
+  header.delta = false; // JSON always carries the full station set
+  parseCommandsJson(doc["commands"], header.commands);
+
+  // Parse current date to "DD MMM YYYY" format
+  const char* timestamp = doc["timestamp"] | "";
+  header.date[0] = '\0';
+  if (strlen(timestamp) >= 10) {
+    formatRegionDate(header.date, sizeof(header.date),
+                     atoi(timestamp), atoi(timestamp + 5), atoi(timestamp + 8));
+  }
+
+  // Parse stations array (one per layout slot)
+  JsonArray stationsArray = doc["stations"];
+  int stationCount = (int)stationsArray.size();
+  if (stationCount > STATION_SLOTS) stationCount = STATION_SLOTS;
+  SpeedUnit displayUnit = regionDisplayUnit(header.regionId); // Resolved once per response
+
+  for (int i = 0; i < stationCount; i++) {
+    JsonObject station = stationsArray[i];
+
+    strlcpy(stations[i].stationName, stationDisplayName(station["stationId"] | ""),
+            sizeof(stations[i].stationName));
+
+    // Extract weather data with proper null handling for v2.0.0 backend
+    JsonObject weatherData = station["data"];
+    JsonObject tempData = weatherData["temperature"];
+    JsonObject windData = weatherData["wind"];
+
+    // Temperature handling - backend v2.0.0 properly returns null for missing data
+    if (tempData.isNull() || tempData["air"].isNull()) {
+      stations[i].temperature = VALUE_MISSING; // Missing data
+    } else {
+      float temp = tempData["air"].as<float>();
+      // Validate temperature range (-60°C to +60°C)
+      if (temp >= TEMPERATURE_RANGE_MIN && temp <= TEMPERATURE_RANGE_MAX) {
+        stations[i].temperature = toTenths(temp);
+      } else {
+        stations[i].temperature = VALUE_MISSING; // Invalid temperature
+      }
+    }
+
+    // Wind speed - backend v2.0.0 always provides in m/s, never null (0 = calm)
+    stations[i].windSpeed = toTenths(windData["avg"].as<float>());
+
+    // Wind gust - backend v2.0.0 returns null for instantaneous-only readings
+    if (windData["gust"].isNull()) {
+      stations[i].windGust = VALUE_MISSING; // No gust data available
+    } else {
+      stations[i].windGust = toTenths(windData["gust"].as<float>());
+    }
+
+    // Wind direction - always available from backend
+    stations[i].windDirection = windData["direction"].as<int>();
+
+    // Set regional display units for user-friendly display
+    stations[i].displayUnit = displayUnit;
+
+    // Format timestamp to time only (HH:MM UTC)
+    setLastUpdateTime(stations[i], station["timestamp"] | "", 11);
+  }
+  for (int i = stationCount; i < STATION_SLOTS; i++) {
+    stations[i].stationName[0] = '\0'; // Layout is picked by the used slots
+  }
+
+  return true;
+}
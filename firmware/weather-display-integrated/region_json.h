@@ -0,0 +1,38 @@
+/**
+ * Region JSON Payload v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * Filtered parse of GET /api/v1/weather/region/{region} into the station
+ * model (weather_model.h). Reads from anything ArduinoJson deserializes -
+ * the HTTP stream on the device, a captured payload in the host benchmark.
+ */
+
+#pragma once
+
+#include <ArduinoJson.h>
+#include "config.h"
+#include "weather_model.h"
+
+// Only the fields the display uses, so REGION_JSON_DOC_SIZE stays small
+void buildRegionJsonFilter(JsonDocument& filter);
+
+template <typename TInput>
+DeserializationError readRegionJson(TInput& input, JsonDocument& doc) {
+  StaticJsonDocument<REGION_JSON_FILTER_SIZE> filter;
+  buildRegionJsonFilter(filter);
+  return deserializeJson(doc, input, DeserializationOption::Filter(filter));
+}
+
+// Hash of the rendered inputs - the envelope timestamp changes on every
+// response, so only its date part is included
+uint32_t regionJsonHash(JsonDocument& doc);
+// Identify request or commands in the payload - it must be applied even when
+// its hash matches the last one
+bool regionJsonHasActions(JsonDocument& doc);
+
+// Command list of the region payload (or the JSON command long-poll body)
+void parseCommandsJson(JsonArrayConst array, DeviceCommandList& commands);
+
+// Fills up to STATION_SLOTS entries of stations from a filtered document and
+// clears the rest
+bool parseRegionJson(JsonDocument& doc, RegionHeader& header, StationData* stations);
@@ -0,0 +1,73 @@
+/**
+ * Region and Station Tables
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * GENERATED by backend/scripts/generate-firmware-regions.ts from
+ * backend/src/config/regions.ts - do not edit by hand.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// FNV-1a of an ID in a constant expression (same hash as fnv1aHash() in the sketch)
+constexpr uint32_t regionIdHash(const char* id, uint32_t hash = 2166136261UL) {
+  return *id ? regionIdHash(id + 1, (hash ^ (uint8_t)*id) * 16777619UL) : hash;
+}
+
+enum SpeedUnit : uint8_t {
+  UNIT_MPS = 0,
+  UNIT_KPH,
+  UNIT_KTS,
+  UNIT_MPH
+};
+
+#define SPEED_FACTOR_SCALE 100000
+#define REGION_MAX_STATIONS 3
+#define STATION_NONE 0xFF
+
+struct SpeedUnitInfo {
+  const char* label;
+  uint32_t factor;          // Display units per m/s, times SPEED_FACTOR_SCALE
+};
+
+struct StationInfo {
+  uint32_t idHash;
+  const char* id;
+  const char* displayName;  // ASCII, as drawn on the panel
+  uint8_t region;           // Index into REGIONS
+};
+
+struct RegionInfo {
+  uint32_t idHash;
+  const char* id;
+  const char* displayName;
+  SpeedUnit displayUnit;
+  uint8_t defaultStation;   // Index into STATIONS
+  uint8_t stationCount;
+  uint8_t stations[REGION_MAX_STATIONS]; // Display order, indices into STATIONS
+};
+
+constexpr SpeedUnitInfo SPEED_UNITS[] = {
+  {"m/s", 100000},
+  {"kph", 360000},
+  {"kts", 194384},
+  {"mph", 223700}
+};
+
+constexpr StationInfo STATIONS[] = {
+  {regionIdHash("prarion"), "prarion", "Prarion", 0},
+  {regionIdHash("planpraz"), "planpraz", "Planpraz", 0},
+  {regionIdHash("tetedebalme"), "tetedebalme", "Tete de Balme", 0},
+  {regionIdHash("lymington"), "lymington", "Lymington", 1},
+  {regionIdHash("brambles"), "brambles", "Brambles", 1},
+  {regionIdHash("seaview"), "seaview", "Seaview", 1}
+};
+
+constexpr RegionInfo REGIONS[] = {
+  {regionIdHash("chamonix"), "chamonix", "Chamonix Valley, France", UNIT_KPH, 0, 3, {0, 1, 2}},
+  {regionIdHash("solent"), "solent", "Solent, UK", UNIT_KTS, 3, 3, {3, 4, 5}}
+};
+
+constexpr int NUM_STATIONS = sizeof(STATIONS) / sizeof(STATIONS[0]);
+constexpr int NUM_REGIONS = sizeof(REGIONS) / sizeof(REGIONS[0]);
@@ -0,0 +1,363 @@
+/**
+ * Resumable TLS Client v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * See tls_session_client.h. The TCP side is the plain WiFiClient base class;
+ * mbedtls runs on top of it through the bioSend/bioRecv callbacks.
+ */
+
+#include "tls_session_client.h"
+#include "config.h"
+#include <mbedtls/net_sockets.h>
+
+#if DEBUG
+  #define TLS_DEBUG_PRINTF(fmt, ...) Serial.printf(fmt, ##__VA_ARGS__)
+#else
+  #define TLS_DEBUG_PRINTF(fmt, ...)
+#endif
+
+// FNV-1a of the host name, so a cache written for another backend is ignored
+static uint32_t hashHost(const char* host) {
+  uint32_t hash = 2166136261UL;
+  while (*host) {
+    hash ^= (uint8_t)*host++;
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+ResumableTlsClient::ResumableTlsClient()
+  : _cache(NULL), _rootCa(NULL), _insecure(false), _handshakeTimeout(10000), _lastHandshakeMs(0), _lastDnsMs(0), _lastUsedCache(false),
+    _tlsActive(false), _handshakeDone(false), _peeked(-1) {
+}
+
+ResumableTlsClient::~ResumableTlsClient() {
+  stop();
+}
+
+// ===============================================================================
+// CONNECTION
+// ===============================================================================
+
+int ResumableTlsClient::connect(IPAddress ip, uint16_t port) {
+  return connect(ip, port, (int32_t)_handshakeTimeout);
+}
+
+int ResumableTlsClient::connect(IPAddress ip, uint16_t port, int32_t timeout) {
+  _host = "";
+  if (!WiFiClient::connect(ip, port, timeout)) {
+    return 0;
+  }
+  return startTls(false) ? 1 : 0;
+}
+
+int ResumableTlsClient::connect(const char* host, uint16_t port) {
+  return connect(host, port, (int32_t)_handshakeTimeout);
+}
+
+int ResumableTlsClient::connect(const char* host, uint16_t port, int32_t timeout) {
+  _host = host;
+  _lastHandshakeMs = 0;
+  _lastDnsMs = 0;
+
+  if (!openSocket(host, port, timeout)) {
+    return 0;
+  }
+
+  bool hadSession = _cache && _cache->sessionLength > 0;
+  if (startTls(hadSession)) {
+    return 1;
+  }
+
+  // Resumption attempt failed outright - drop the session and do one full handshake
+  if (hadSession) {
+    TLS_DEBUG_PRINTF("TLS resumption failed - retrying with full handshake\n");
+    clearSessionCache();
+    if (openSocket(host, port, timeout) && startTls(false)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+bool ResumableTlsClient::openSocket(const char* host, uint16_t port, int32_t timeout) {
+  uint32_t hostHash = hashHost(host);
+
+  if (_cache && _cache->hostHash != hostHash) {
+    memset(_cache, 0, sizeof(*_cache));
+    _cache->hostHash = hostHash;
+  }
+
+  // Cached address first - skips the DNS round trip
+  if (_cache && _cache->resolvedIp != 0) {
+    if (WiFiClient::connect(IPAddress(_cache->resolvedIp), port, timeout)) {
+      return true;
+    }
+    TLS_DEBUG_PRINTF("Cached backend IP unreachable - resolving again\n");
+    _cache->resolvedIp = 0;
+  }
+
+  IPAddress ip;
+  unsigned long dnsStart = millis();
+  bool resolved = WiFi.hostByName(host, ip);
+  _lastDnsMs += millis() - dnsStart;
+  if (!resolved) {
+    TLS_DEBUG_PRINTF("DNS lookup failed for %s\n", host);
+    return false;
+  }
+  if (!WiFiClient::connect(ip, port, timeout)) {
+    return false;
+  }
+
+  if (_cache) {
+    _cache->resolvedIp = (uint32_t)ip;
+  }
+  return true;
+}
+
+bool ResumableTlsClient::startTls(bool useCachedSession) {
+  unsigned long start = millis();
+
+  mbedtls_ssl_init(&_ssl);
+  mbedtls_ssl_config_init(&_conf);
+  mbedtls_ctr_drbg_init(&_drbg);
+  mbedtls_entropy_init(&_entropy);
+  mbedtls_x509_crt_init(&_caChain);
+  _tlsActive = true;
+  _handshakeDone = false;
+  _peeked = -1;
+  _lastUsedCache = false;
+
+  int ret = mbedtls_ctr_drbg_seed(&_drbg, mbedtls_entropy_func, &_entropy, NULL, 0);
+  if (ret == 0) {
+    ret = mbedtls_ssl_config_defaults(&_conf, MBEDTLS_SSL_IS_CLIENT,
+                                      MBEDTLS_SSL_TRANSPORT_STREAM, MBEDTLS_SSL_PRESET_DEFAULT);
+  }
+  if (ret != 0) {
+    TLS_DEBUG_PRINTF("TLS setup failed: -0x%04x\n", -ret);
+    stop();
+    return false;
+  }
+
+  if (_insecure) {
+    mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_NONE);
+  } else {
+    // PEM parsing needs the terminating NUL in the length
+    ret = _rootCa ? mbedtls_x509_crt_parse(&_caChain, (const unsigned char*)_rootCa, strlen(_rootCa) + 1)
+                  : MBEDTLS_ERR_X509_BAD_INPUT_DATA;
+    if (ret != 0) {
+      TLS_DEBUG_PRINTF("No usable root CA: -0x%04x\n", -ret);
+      stop();
+      return false;
+    }
+    mbedtls_ssl_conf_authmode(&_conf, MBEDTLS_SSL_VERIFY_REQUIRED);
+    mbedtls_ssl_conf_ca_chain(&_conf, &_caChain, NULL);
+  }
+  mbedtls_ssl_conf_rng(&_conf, mbedtls_ctr_drbg_random, &_drbg);
+#if defined(MBEDTLS_SSL_SESSION_TICKETS)
+  mbedtls_ssl_conf_session_tickets(&_conf, MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif
+
+  ret = mbedtls_ssl_setup(&_ssl, &_conf);
+  if (ret == 0 && _host.length() > 0) {
+    ret = mbedtls_ssl_set_hostname(&_ssl, _host.c_str()); // SNI
+  }
+  if (ret != 0) {
+    TLS_DEBUG_PRINTF("TLS setup failed: -0x%04x\n", -ret);
+    stop();
+    return false;
+  }
+  mbedtls_ssl_set_bio(&_ssl, this, bioSend, bioRecv, NULL);
+
+  // Offer the cached session - the server either resumes it or silently
+  // falls back to a full handshake
+  if (useCachedSession && _cache && _cache->sessionLength > 0) {
+    mbedtls_ssl_session session;
+    mbedtls_ssl_session_init(&session);
+    if (mbedtls_ssl_session_load(&session, _cache->session, _cache->sessionLength) == 0 &&
+        mbedtls_ssl_set_session(&_ssl, &session) == 0) {
+      _lastUsedCache = true;
+    } else {
+      clearSessionCache();
+    }
+    mbedtls_ssl_session_free(&session);
+  }
+
+  while ((ret = mbedtls_ssl_handshake(&_ssl)) != 0) {
+    if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      TLS_DEBUG_PRINTF("TLS handshake failed: -0x%04x (verify flags 0x%x)\n", -ret,
+                       (unsigned)mbedtls_ssl_get_verify_result(&_ssl));
+      stop();
+      return false;
+    }
+    if (millis() - start > _handshakeTimeout) {
+      TLS_DEBUG_PRINTF("TLS handshake timed out\n");
+      stop();
+      return false;
+    }
+    delay(1);
+  }
+
+  _handshakeDone = true;
+  _lastHandshakeMs = millis() - start;
+  TLS_DEBUG_PRINTF("TLS handshake %lums (%s)\n", _lastHandshakeMs,
+                   _lastUsedCache ? "session offered" : "full");
+  return true;
+}
+
+// Saved on stop() rather than after the handshake: TLS 1.3 tickets arrive
+// after the handshake, while the response is being read
+void ResumableTlsClient::saveSession() {
+  if (!_cache || !_handshakeDone) {
+    return;
+  }
+
+  mbedtls_ssl_session session;
+  mbedtls_ssl_session_init(&session);
+
+  size_t length = 0;
+  if (mbedtls_ssl_get_session(&_ssl, &session) == 0 &&
+      mbedtls_ssl_session_save(&session, _cache->session, sizeof(_cache->session), &length) == 0) {
+    _cache->sessionLength = (uint16_t)length;
+  } else {
+    _cache->sessionLength = 0; // Too large for the cache or not resumable
+  }
+
+  mbedtls_ssl_session_free(&session);
+}
+
+void ResumableTlsClient::clearSessionCache() {
+  if (_cache) {
+    _cache->sessionLength = 0;
+  }
+}
+
+void ResumableTlsClient::freeTls() {
+  mbedtls_ssl_free(&_ssl);
+  mbedtls_ssl_config_free(&_conf);
+  mbedtls_ctr_drbg_free(&_drbg);
+  mbedtls_entropy_free(&_entropy);
+  mbedtls_x509_crt_free(&_caChain);
+  _tlsActive = false;
+  _handshakeDone = false;
+}
+
+void ResumableTlsClient::stop() {
+  if (_tlsActive) {
+    saveSession();
+    if (_handshakeDone) {
+      mbedtls_ssl_close_notify(&_ssl);
+    }
+    freeTls();
+  }
+  _peeked = -1;
+  WiFiClient::stop();
+}
+
+uint8_t ResumableTlsClient::connected() {
+  if (!_tlsActive) {
+    return 0;
+  }
+  return (available() > 0) || WiFiClient::connected();
+}
+
+// ===============================================================================
+// DATA TRANSFER
+// ===============================================================================
+
+size_t ResumableTlsClient::write(uint8_t b) {
+  return write(&b, 1);
+}
+
+size_t ResumableTlsClient::write(const uint8_t* buf, size_t size) {
+  if (!_handshakeDone) {
+    return 0;
+  }
+
+  size_t written = 0;
+  while (written < size) {
+    int ret = mbedtls_ssl_write(&_ssl, buf + written, size - written);
+    if (ret > 0) {
+      written += ret;
+    } else if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE) {
+      TLS_DEBUG_PRINTF("TLS write failed: -0x%04x\n", -ret);
+      break;
+    }
+  }
+  return written;
+}
+
+int ResumableTlsClient::available() {
+  if (!_handshakeDone) {
+    return 0;
+  }
+
+  int pending = (_peeked >= 0) ? 1 : 0;
+
+  // Process a buffered record without consuming application data
+  if (mbedtls_ssl_get_bytes_avail(&_ssl) == 0 && WiFiClient::available() > 0) {
+    mbedtls_ssl_read(&_ssl, NULL, 0);
+  }
+  return pending + (int)mbedtls_ssl_get_bytes_avail(&_ssl);
+}
+
+int ResumableTlsClient::read() {
+  uint8_t c;
+  return (read(&c, 1) == 1) ? c : -1;
+}
+
+int ResumableTlsClient::read(uint8_t* buf, size_t size) {
+  if (!_handshakeDone || size == 0) {
+    return -1;
+  }
+
+  int count = 0;
+  if (_peeked >= 0) {
+    buf[count++] = (uint8_t)_peeked;
+    _peeked = -1;
+    if (size == 1) {
+      return 1;
+    }
+  }
+
+  int ret = mbedtls_ssl_read(&_ssl, buf + count, size - count);
+  if (ret > 0) {
+    return count + ret;
+  }
+  return (count > 0) ? count : -1; // WANT_READ, close notify or error
+}
+
+int ResumableTlsClient::peek() {
+  if (_peeked < 0) {
+    _peeked = read();
+  }
+  return _peeked;
+}
+
+void ResumableTlsClient::flush() {
+  // Nothing buffered on the write side; WiFiClient::flush() would discard
+  // encrypted bytes mbedtls has not read yet
+}
+
+// ===============================================================================
+// MBEDTLS TRANSPORT CALLBACKS
+// ===============================================================================
+
+int ResumableTlsClient::bioSend(void* ctx, const unsigned char* buf, size_t len) {
+  ResumableTlsClient* self = static_cast<ResumableTlsClient*>(ctx);
+  size_t written = self->WiFiClient::write(buf, len);
+  if (written == 0) {
+    return self->WiFiClient::connected() ? MBEDTLS_ERR_SSL_WANT_WRITE : MBEDTLS_ERR_NET_CONN_RESET;
+  }
+  return (int)written;
+}
+
+int ResumableTlsClient::bioRecv(void* ctx, unsigned char* buf, size_t len) {
+  ResumableTlsClient* self = static_cast<ResumableTlsClient*>(ctx);
+  int availableBytes = self->WiFiClient::available();
+  if (availableBytes <= 0) {
+    return self->WiFiClient::connected() ? MBEDTLS_ERR_SSL_WANT_READ : MBEDTLS_ERR_NET_CONN_RESET;
+  }
+  int ret = self->WiFiClient::read(buf, min(len, (size_t)availableBytes));
+  return (ret > 0) ? ret : MBEDTLS_ERR_SSL_WANT_READ;
+}
@@ -0,0 +1,91 @@
+/**
+ * Resumable TLS Client v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * WiFiClient drop-in for HTTPClient that keeps the TLS session and the resolved
+ * backend IP in caller-provided memory (RTC slow memory in the sketch), so the
+ * next wake can do an abbreviated handshake and skip DNS. Falls back to a full
+ * handshake whenever the cached session is missing or rejected. The server
+ * certificate is verified against the root CA given with setCACert(); a client
+ * with neither setCACert() nor setInsecure() refuses to connect.
+ */
+
+#pragma once
+
+#include <WiFi.h>
+#include <mbedtls/ssl.h>
+#include <mbedtls/entropy.h>
+#include <mbedtls/ctr_drbg.h>
+#include <mbedtls/x509_crt.h>
+
+// Serialized mbedtls session (includes the peer certificate when
+// MBEDTLS_SSL_KEEP_PEER_CERTIFICATE is enabled, as in the ESP32 core)
+#define TLS_SESSION_BLOB_SIZE 2048
+
+struct TlsSessionCache {
+  uint32_t hostHash;        // Host the entries belong to (0 = empty)
+  uint32_t resolvedIp;      // Cached DNS result (0 = resolve again)
+  uint16_t sessionLength;   // Serialized session bytes (0 = full handshake)
+  uint8_t session[TLS_SESSION_BLOB_SIZE];
+};
+
+class ResumableTlsClient : public WiFiClient {
+public:
+  ResumableTlsClient();
+  ~ResumableTlsClient();
+
+  void setSessionCache(TlsSessionCache* cache) { _cache = cache; }
+  // Root CA(s), PEM, the server certificate must chain to (one or more
+  // concatenated certificates; the string must outlive the client)
+  void setCACert(const char* rootCa) { _rootCa = rootCa; _insecure = false; }
+  // Skip server verification - for testing against a local backend only
+  void setInsecure() { _rootCa = NULL; _insecure = true; }
+  void setHandshakeTimeout(unsigned long timeoutMs) { _handshakeTimeout = timeoutMs; }
+  unsigned long lastHandshakeMs() const { return _lastHandshakeMs; }
+  unsigned long lastDnsMs() const { return _lastDnsMs; }
+  bool lastHandshakeUsedCache() const { return _lastUsedCache; }
+
+  int connect(IPAddress ip, uint16_t port);
+  int connect(IPAddress ip, uint16_t port, int32_t timeout);
+  int connect(const char* host, uint16_t port);
+  int connect(const char* host, uint16_t port, int32_t timeout);
+
+  size_t write(uint8_t b);
+  size_t write(const uint8_t* buf, size_t size);
+  int available();
+  int read();
+  int read(uint8_t* buf, size_t size);
+  int peek();
+  void flush();
+  void stop();
+  uint8_t connected();
+  operator bool() { return connected(); }
+
+private:
+  bool openSocket(const char* host, uint16_t port, int32_t timeout);
+  bool startTls(bool useCachedSession);
+  void saveSession();
+  void clearSessionCache();
+  void freeTls();
+
+  static int bioSend(void* ctx, const unsigned char* buf, size_t len);
+  static int bioRecv(void* ctx, unsigned char* buf, size_t len);
+
+  TlsSessionCache* _cache;
+  const char* _rootCa;
+  bool _insecure;
+  unsigned long _handshakeTimeout;
+  unsigned long _lastHandshakeMs;
+  unsigned long _lastDnsMs;
+  bool _lastUsedCache;
+  bool _tlsActive;
+  bool _handshakeDone;
+  int _peeked;
+  String _host;
+
+  mbedtls_ssl_context _ssl;
+  mbedtls_ssl_config _conf;
+  mbedtls_ctr_drbg_context _drbg;
+  mbedtls_entropy_context _entropy;
+  mbedtls_x509_crt _caChain;
+};
@@ -21,6 +21,41 @@
  * - MAC-based device identification
  * - Web-triggered device identification (flash display)
  * 
+ * v2.2.0 Changes (Power & Latency, unreleased):
+ * - Warm wake: timer wakes restore the last cycle from RTC memory and skip cold boot
+ * - Fast WiFi reconnect: cached BSSID/channel/lease (or static IP), scan only as fallback
+ * - Changed-only refresh: rendered-content fingerprint skips identical panel refreshes
+ * - Partial refresh: only dirty field/footer rectangles are pushed, full refresh every N cycles
+ * - Adaptive anti-ghosting: single black pass only every K refreshes (sooner when cold)
+ * - Pipelined cycle: display task refreshes the panel while the heartbeat is in flight
+ * - Combined heartbeat: telemetry rides on the weather request (one TLS handshake per cycle)
+ * - TLS session resumption: session ticket/ID and backend IP kept in RTC memory across sleep
+ * - Conditional GET: If-None-Match with the cached ETag, 304 skips download, parse and refresh
+ * - Compact binary region payload (?format=bin): fixed little-endian layout, no JSON document
+ * - Delta updates (&delta=1): only changed station fields against the cached version, merged
+ *   into the kept stations; only changed fields are redrawn while the frame buffer is intact
+ * - Streaming JSON fallback: filtered parse straight from the HTTP stream into a fixed document
+ * - Allocation-free render model: fixed-point station values, char buffers, snprintf fields
+ * - Generated constexpr station/region/unit tables (regions_generated.h from the backend config)
+ * - Phase profiler: per-phase awake time of the last N cycles in RTC memory, sent in telemetry
+ * - Energy profiler: per-phase and per-cycle charge (mA·s), modelled or sampled through a
+ *   test-rig shunt, in telemetry and as a full trace with the heartbeat
+ * - Adaptive scheduler: longer sleeps while data is unchanged or the backend hints night hours,
+ *   shorter while wind is changing fast or gusting
+ * - Battery monitor: averaged ADC sample before WiFi starts, conserve and critical power modes
+ * - Power profile: idle CPU clock outside TLS/parsing, modem sleep after the last request
+ * - Light-sleep loop: automatic light sleep between cycles when staying awake, commands by long-poll
+ * - Device commands: identify, region reassignment, interval change and forced refresh queued on
+ *   the backend, collected with the region request and acknowledged on the next one
+ * - Static layer cache: names, labels and rules rasterized once per station set, values drawn on top
+ * - Station layouts: 1x3, 2x2 and 2x3 grids as constexpr tables, picked by the region's station count
+ * - Wind trends: 2 hours of quantized avg/gust/direction per station in RTC memory, drawn as
+ *   sparklines and refreshed through their own dirty rectangles
+ * - Direct 1-bpp frame buffer: memset clears, word-wide fills, row-wise glyph blits
+ * - Last-known-good data stays up through failures with a footer staleness marker
+ * - Retry policy: per-cycle radio budget, jittered exponential backoff kept across sleeps
+ * - Parse and layout split into plain C++ modules, benchmarked on the host (firmware/bench)
+ * 
  * v2.1.8 Changes (WiFi Signal Bars):
  * - Replaced WiFi dBm text with visual signal strength bars
  * - Added 4-bar signal indicator (like cell phone signal bars)
@@ -98,6 +133,21 @@
 #include <ArduinoJson.h>
 #include <Preferences.h>
 #include <esp_sleep.h>  // v2.1.0: ESP32 deep sleep functionality
+#include <esp_timer.h>  // v2.2.0: Phase profiler timestamps
+#include <esp_pm.h>     // v2.2.0: Automatic light sleep between cycles
+#include <freertos/FreeRTOS.h>  // v2.2.0: Display task pipeline
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include "tls_session_client.h"  // v2.2.0: TLS session resumption across deep sleep
+#include "regions_generated.h"   // v2.2.0: Station/region/unit tables generated from the backend
+#include "frame_buffer.h"        // v2.2.0: Direct 1-bpp drawing into the ePaper frame buffer
+#include "weather_model.h"       // v2.2.0: Station model, binary payload, units and formatting
+#include "region_json.h"         // v2.2.0: Filtered region JSON parse
+#include "weather_layout.h"      // v2.2.0: Station columns and status footer
+
+#if TLS_VERIFY_SERVER && !defined(BACKEND_ROOT_CA)
+#error "TLS_VERIFY_SERVER needs BACKEND_ROOT_CA in secrets.h - see secrets.h.example"
+#endif
 
 // ===============================================================================
 // GLOBAL VARIABLES  
@@ -105,6 +155,7 @@
 
 #ifdef EPAPER_ENABLE
 EPaper epaper;
+FrameBuffer frame; // v2.2.0: Clears, rules, rects and GFX text straight into epaper's buffer
 #endif
 
 // Device identification
@@ -118,36 +169,142 @@ unsigned long lastHeartbeat = 0;
 unsigned long lastWiFiCheck = 0;
 bool wifiConnected = false;
 int wifiReconnectAttempts = 0;
+unsigned long radioBudgetStart = 0; // v2.2.0: millis() when this cycle's radio time started
 
-// Weather data - now supports 3 stations per region with v2.0.0 backend compatibility
+// Weather data - v2.2.0: up to STATION_SLOTS stations per region, laid out by weather_layout.h
 String currentRegionId = "";
 String regionDisplayName = "";
-struct StationData {
-  String stationName;
-  float temperature;    // NAN if null/unavailable
-  float windSpeed;      // Always available from backend (0.0 = calm)
-  float windGust;       // NAN if null/unavailable (instantaneous only)
-  int windDirection;    // Always available (0-359)
-  String windUnit;      // Backend always sends "m/s", display unit varies by region
-  String displayUnit;   // Regional display unit ("kph" for alpine, "kts" for marine)
-  String lastUpdateTime;
-};
-StationData stations[3]; // Array for 3 stations per region
+StationData stations[STATION_SLOTS]; // v2.2.0: Model in weather_model.h, unused slots have no name
+StationHistory stationHistory[STATION_SLOTS]; // v2.2.0: Wind trend per slot, kept in wakeState across sleeps
 bool dataValid = false;
 String currentDate = "";
 
 // Display state
 bool needsDisplayUpdate = true;
+bool forceDisplayRefresh = false; // v2.2.0: Bypass the changed-only check (panel was overwritten)
+bool frameHoldsWeather = false;   // v2.2.0: Frame buffer holds the weather frame on the panel (lost in deep sleep)
 bool identifyRequested = false;
 unsigned long lastFullRefresh = 0;
 int refreshCycle = 0;
 
+// v2.2.0: Dirty-rectangle regions for partial refresh - one per field line per
+// station slot and one per trend box (layout geometry in weather_layout.h),
+// plus the footer elements that change between cycles
+#define NUM_STATION_REGIONS (STATION_SLOTS * FIELDS_PER_STATION)
+#define REGION_TREND_FIRST (NUM_STATION_REGIONS)
+#define REGION_FOOTER_UPDATED (REGION_TREND_FIRST + STATION_SLOTS)
+#define REGION_FOOTER_WIFI (REGION_FOOTER_UPDATED + 1)
+#define REGION_FOOTER_STALE (REGION_FOOTER_UPDATED + 2)
+#define NUM_DISPLAY_REGIONS (REGION_FOOTER_UPDATED + 3)
+
 // Error tracking
 String lastError = "";
 unsigned long lastErrorTime = 0;
 
 // Preferences for persistent storage
 Preferences preferences;
+bool preferencesOpen = false;
+
+// v2.2.0: Warm-wake state retained in RTC slow memory across deep sleep
+#define WAKE_STATE_MAGIC 0x57445335 // "WDS5" - invalidates state from older layouts
+
+// v2.2.0: Phase profiler - where each cycle's awake time goes (order matches the
+// backend's TELEMETRY_PHASES)
+enum ProfilePhase {
+  PHASE_BOOT = 0,       // Reset until WiFi start (ROM, display init, settings)
+  PHASE_WIFI,           // connectToWiFi()
+  PHASE_DNS,            // Backend host lookup
+  PHASE_TLS,            // TLS handshake
+  PHASE_HTTP,           // Request/response time excluding DNS and TLS
+  PHASE_PARSE,          // Body read and decode
+  PHASE_RENDER,         // Drawing into the frame buffer
+  PHASE_PANEL,          // epaper.update() including the BUSY wait
+  PHASE_HEARTBEAT,      // Separate heartbeat POST
+  PHASE_SLEEP,          // enterPowerSaveMode() until deep sleep
+  NUM_PROFILE_PHASES
+};
+struct CycleProfile {
+  uint32_t cycle;                        // wakeState.cycleCount of the cycle
+  uint16_t phaseMs[NUM_PROFILE_PHASES];
+  uint16_t phaseCharge[NUM_PROFILE_PHASES]; // v2.2.0: Tenths of mA·s per phase
+  uint16_t awakeCharge;                  // Tenths of mA·s over the whole awake time (phases overlap)
+  uint16_t sleepCharge;                  // Tenths of mA·s of the deep sleep that followed (modelled)
+  bool measured;                         // Any of it sampled through the shunt
+};
+const uint16_t ENERGY_MODEL_MA[NUM_PROFILE_PHASES] = ENERGY_MODEL_PHASE_MA;
+
+// v2.2.0: Power modes from the battery voltage (reported in telemetry as pm=)
+enum PowerMode : uint8_t {
+  POWER_NORMAL = 0,     // Full schedule
+  POWER_CONSERVE,       // Longer intervals, telemetry every Nth cycle, partial refresh only
+  POWER_CRITICAL        // Low-battery frame, then long deep sleep without WiFi
+};
+uint16_t batterySampleMv = 0; // This wake's averaged reading (0 = no battery sensed)
+
+// v2.2.0: Power management locks (only when automatic light sleep is available)
+bool pmActive = false;
+bool cpuAtFullSpeed = false;
+esp_pm_lock_handle_t cpuMaxLock = NULL;    // Full clock (TLS, parsing)
+esp_pm_lock_handle_t apbMaxLock = NULL;    // Idle clock while a cycle runs
+esp_pm_lock_handle_t noSleepLock = NULL;   // No light sleep while a cycle runs
+struct WakeState {
+  uint32_t magic;
+  uint32_t cycleCount;        // Wake cycles since last cold boot
+  bool isRegistered;
+  bool dataValid;
+  char regionId[16];
+  uint32_t payloadHash;       // FNV-1a of the last region payload
+  char etag[24];              // ETag of the last region payload ("" = unconditional GET)
+  uint8_t wifiBssid[6];       // Last successful access point
+  int32_t wifiChannel;        // 0 = unknown
+  uint64_t elapsedMs;         // Awake + sleep time before this wake (monotonic clock base)
+  uint32_t lastAwakeMs;       // Awake time of the previous cycle (reported in telemetry)
+  uint32_t displayFingerprint;      // Hash of the content currently on the panel (0 = unknown)
+  uint64_t lastDisplayRefreshMs;    // monotonicMillis() of the last panel refresh
+  uint32_t regionHashes[NUM_DISPLAY_REGIONS]; // Per-region content on the panel
+  bool panelShowsData;              // Panel holds the weather layout (not the error screen)
+  uint16_t partialRefreshCount;     // Partial refreshes since the last full refresh
+  uint16_t refreshesSinceClean;     // Panel refreshes since the last anti-ghosting clean
+  int8_t wifiNetworkIndex;    // Index into WIFI_NETWORKS, -1 = none cached
+  uint32_t wifiIp;            // Last DHCP lease (0 = none, renew via DHCP)
+  uint32_t wifiGateway;
+  uint32_t wifiSubnet;
+  uint32_t wifiDns;
+  StationData stations[STATION_SLOTS];
+  TlsSessionCache tlsSession; // Backend TLS session + resolved IP (abbreviated handshake)
+  CycleProfile profileCurrent;                 // Cycle being measured
+  CycleProfile profileRing[PROFILE_RING_SIZE]; // Last completed cycles
+  uint8_t profileHead;                         // Next ring slot
+  uint8_t profileCount;                        // Valid ring entries
+  bool profileCycleDone;                       // Current cycle finished without deep sleep
+  uint32_t updateIntervalMs;  // Scheduled interval to the next cycle (0 = WEATHER_UPDATE_INTERVAL)
+  uint16_t pollHintS;         // Backend X-Next-Poll hint (0 = none)
+  uint8_t unchangedStreak;    // Consecutive cycles without new data
+  bool windActive;            // Last new data had fast-changing wind or strong gusts
+  uint16_t batteryMv;         // Smoothed battery voltage (0 = no battery sensed)
+  PowerMode powerMode;
+  bool lowBatteryShown;       // Panel holds the low-battery frame
+  uint64_t lastGoodDataMs;    // monotonicMillis() when the data was last confirmed current (0 = never)
+  uint64_t failingSinceMs;    // monotonicMillis() of the first failure in a row (0 = not failing)
+  uint8_t failureStreak;      // Consecutive cycles without a backend response (WiFi or HTTP)
+  uint32_t lastCommandId;     // Last backend command applied (sent as X-Command-Ack)
+  StationHistory history[STATION_SLOTS]; // Wind trend per station slot (~130 bytes each)
+};
+RTC_DATA_ATTR WakeState wakeState;
+bool warmWake = false;
+
+// v2.2.0: One TLS transport for all backend requests, session cached in wakeState
+ResumableTlsClient backendTlsClient;
+
+// v2.2.0: Display pipeline - the network side hands a copy of the parsed
+// stations to the display task, which renders and waits on BUSY in parallel
+struct DisplayJob {
+  StationData stations[STATION_SLOTS];
+  StationHistory history[STATION_SLOTS];
+  bool dataValid;
+};
+QueueHandle_t displayQueue = NULL;
+SemaphoreHandle_t displayDone = NULL;
 
 // ===============================================================================
 // SETUP FUNCTION
@@ -155,6 +312,17 @@ Preferences preferences;
 
 void setup() {
   Serial.begin(115200);
+  energyBegin(); // v2.2.0: First, so the shunt samples cover as much of the boot as possible
+  
+  // v2.2.0: Timer wake with valid RTC state resumes the last cycle and skips cold boot work
+  warmWake = (esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER) &&
+             (wakeState.magic == WAKE_STATE_MAGIC);
+  
+  if (warmWake) {
+    warmWakeSetup();
+    return;
+  }
+  
   delay(2000); // Allow serial monitor to connect
   
   // v2.1.5: Enhanced serial output for debugging without visual startup screen
@@ -179,8 +347,12 @@ void setup() {
   pinMode(LED_BUILTIN, OUTPUT);
   digitalWrite(LED_BUILTIN, LOW);
   
+  // v2.2.0: Battery first, while the radio is still off
+  sampleBattery();
+  initPowerManagement();
+  
   // Initialize preferences
-  preferences.begin("weather-display", false);
+  openPreferences();
   
   // Get MAC address for device identification
   WiFi.mode(WIFI_STA);
@@ -209,13 +381,21 @@ void setup() {
   
   // v2.1.3: Wake ePaper display in case we're coming from deep sleep
   wakePowerSaveMode();
-  
-  // Initialize WiFi
-  initializeWiFi();
+  startDisplayPipeline();
   
   // Load persisted settings
   loadSettings();
   
+  // v2.2.0: Start a fresh RTC wake state for this power-on
+  resetWakeState();
+  if (updatePowerMode() == POWER_CRITICAL) {
+    enterCriticalSleep();
+  }
+  profileRecord(PHASE_BOOT, 0);
+  
+  // Initialize WiFi
+  initializeWiFi();
+  
   DEBUG_PRINTF("Free heap after setup: %d bytes\n", ESP.getFreeHeap());
   DEBUG_PRINTLN("Setup complete! Starting weather updates...");
   
@@ -224,17 +404,55 @@ void setup() {
   lastHeartbeat = 0;
 }
 
+// v2.2.0: Warm wake path - no serial delay, banner or NVS reads, straight to the fetch
+void warmWakeSetup() {
+  wakeState.cycleCount++;
+  DEBUG_PRINTF("=== v2.2.0 WARM WAKE (cycle %lu) ===\n", (unsigned long)wakeState.cycleCount);
+  
+  pinMode(LED_BUILTIN, OUTPUT);
+  digitalWrite(LED_BUILTIN, LOW);
+  sampleBattery();
+  initPowerManagement();
+  
+  WiFi.mode(WIFI_STA);
+  deviceMAC = WiFi.macAddress();
+  deviceId = deviceMAC;
+  deviceId.replace(":", "");
+  deviceId.toLowerCase();
+  
+  initializeDisplay();
+  wakePowerSaveMode();
+  startDisplayPipeline();
+  
+  restoreWakeState();
+  if (updatePowerMode() == POWER_CRITICAL) {
+    enterCriticalSleep();
+  }
+  profileRecord(PHASE_BOOT, 0);
+  
+  initializeWiFi();
+  
+  // The panel still shows the last frame - only redraw when the fetch brings changes,
+  // the connection is lost or the frame is unknown (e.g. the low-battery screen)
+  needsDisplayUpdate = !wifiConnected || wakeState.displayFingerprint == 0;
+  
+  // Force immediate update (millis() restarts from zero after deep sleep)
+  lastWeatherUpdate = 0;
+  lastHeartbeat = 0;
+}
+
 // ===============================================================================
 // POWER MANAGEMENT FUNCTIONS - v2.1.0
 // ===============================================================================
 
 void enterPowerSaveMode() {
   DEBUG_PRINTLN("=== v2.1.3 ENTERING POWER SAVE MODE ===");
+  int64_t sleepStart = esp_timer_get_time();
   
   // Calculate remaining sleep time until next update
   unsigned long currentTime = millis();
   unsigned long timeSinceLastUpdate = currentTime - lastWeatherUpdate;
-  unsigned long remainingSleepTime = WEATHER_UPDATE_INTERVAL - timeSinceLastUpdate;
+  unsigned long remainingSleepTime = currentUpdateInterval() - timeSinceLastUpdate;
   
   // Minimum sleep time to make it worthwhile
   if (remainingSleepTime < MINIMUM_SLEEP_TIME) {
@@ -255,6 +473,14 @@ void enterPowerSaveMode() {
   DEBUG_PRINTF("Entering ESP32 deep sleep for %dm %ds\n", sleepMinutes, sleepSeconds);
   DEBUG_PRINTLN("Device will wake up for next weather update cycle");
   
+  // v2.2.0: Persist this cycle's state so the next timer wake can skip cold boot
+  profileRecord(PHASE_SLEEP, sleepStart);
+  wakeState.profileCurrent.sleepCharge = energySleepCharge(remainingSleepTime);
+  profileCommitCycle();
+  wakeState.lastAwakeMs = millis();
+  wakeState.elapsedMs += millis() + remainingSleepTime;
+  saveWakeState();
+  
   // Flush serial output before sleeping
   Serial.flush();
   
@@ -267,6 +493,37 @@ void enterPowerSaveMode() {
   // This line will never be reached as ESP32 restarts after deep sleep
 }
 
+// v2.2.0: Critical battery - one final low-battery frame, then sleep long without
+// starting WiFi. Each wake re-checks the battery and resumes once it is charged.
+void enterCriticalSleep() {
+  DEBUG_PRINTF("=== CRITICAL BATTERY (%umV) - LONG DEEP SLEEP ===\n", wakeState.batteryMv);
+  
+#ifdef EPAPER_ENABLE
+  if (!wakeState.lowBatteryShown) {
+    epaper.wake();
+    frame.fillScreen(TFT_WHITE);
+    drawLowBatteryScreen();
+    epaper.update();
+    frameHoldsWeather = false;
+    
+    // The next normal refresh must redraw the whole frame
+    wakeState.lowBatteryShown = true;
+    wakeState.displayFingerprint = 0;
+    wakeState.panelShowsData = false;
+    wakeState.partialRefreshCount = 0;
+  }
+  epaper.sleep();
+#endif
+  
+  wakeState.lastAwakeMs = millis();
+  wakeState.elapsedMs += millis() + CRITICAL_SLEEP_TIME;
+  saveWakeState();
+  
+  Serial.flush();
+  esp_sleep_enable_timer_wakeup(CRITICAL_SLEEP_TIME * 1000ULL);
+  esp_deep_sleep_start();
+}
+
 void wakePowerSaveMode() {
   DEBUG_PRINTLN("=== v2.1.3 WAKING FROM POWER SAVE MODE ===");
   
@@ -279,6 +536,208 @@ void wakePowerSaveMode() {
   DEBUG_PRINTLN("Power save mode wake complete - ready for operations");
 }
 
+// v2.2.0: Power profile - the full clock only for the CPU-bound work (TLS handshake,
+// decrypting and parsing the payload). WiFi/BUSY waits, loop delays and drawing run
+// at the idle clock; APB stays at 80 MHz on the C3, so SPI and UART timing hold.
+// Only the loop task switches the clock.
+void cpuFullSpeed(bool full) {
+#if POWER_PROFILE
+  if (pmActive) {
+    // Power management owns the clock - express the same profile as locks
+    if (full && !cpuAtFullSpeed) {
+      esp_pm_lock_acquire(cpuMaxLock);
+    } else if (!full && cpuAtFullSpeed) {
+      esp_pm_lock_release(cpuMaxLock);
+    }
+  } else {
+    uint32_t targetMhz = full ? CPU_FREQ_FULL_MHZ : CPU_FREQ_IDLE_MHZ;
+    if (getCpuFrequencyMhz() != targetMhz) {
+      setCpuFrequencyMhz(targetMhz);
+    }
+  }
+  cpuAtFullSpeed = full;
+#endif
+}
+
+// v2.2.0: Automatic light sleep needs power management and tickless idle in the
+// ESP32 core build - without them the loop idles in modem sleep at the idle clock.
+// Either way the cycle itself starts at the idle clock.
+void initPowerManagement() {
+#if LIGHT_SLEEP_LOOP
+  esp_pm_config_esp32c3_t config = {};
+  config.max_freq_mhz = CPU_FREQ_FULL_MHZ;
+  config.min_freq_mhz = LIGHT_SLEEP_MIN_FREQ_MHZ;
+  config.light_sleep_enable = true;
+  
+  esp_err_t err = esp_pm_configure(&config);
+  if (err == ESP_OK &&
+      esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "cpu", &cpuMaxLock) == ESP_OK &&
+      esp_pm_lock_create(ESP_PM_APB_FREQ_MAX, 0, "apb", &apbMaxLock) == ESP_OK &&
+      esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "cycle", &noSleepLock) == ESP_OK) {
+    esp_pm_lock_acquire(apbMaxLock);
+    esp_pm_lock_acquire(noSleepLock);
+    pmActive = true;
+    DEBUG_PRINTLN("Automatic light sleep enabled between cycles");
+  } else {
+    DEBUG_PRINTF("Automatic light sleep unavailable (%s) - idling in modem sleep\n", esp_err_to_name(err));
+  }
+#endif
+  cpuFullSpeed(false);
+}
+
+// v2.2.0: Between cycles - drop the locks so the CPU light-sleeps between DTIM
+// beacons (the association is kept, the modem wakes on its listen interval)
+void setLightSleepIdle(bool idle) {
+  if (!pmActive) return;
+  
+  if (idle) {
+    if (wifiConnected) {
+      WiFi.setSleep(WIFI_PS_MAX_MODEM); // Light sleep with WiFi requires modem sleep
+    }
+    esp_pm_lock_release(noSleepLock);
+    esp_pm_lock_release(apbMaxLock);
+  } else {
+    esp_pm_lock_acquire(apbMaxLock);
+    esp_pm_lock_acquire(noSleepLock);
+  }
+}
+
+// v2.2.0: Stay-awake wait until the next cycle (deep sleep disabled, or the
+// remaining time too short for it). In light-sleep mode the wait is a command
+// long-poll, so identify and config changes arrive within seconds instead of next cycle.
+void idleUntilNextCycle() {
+#if LIGHT_SLEEP_LOOP
+  unsigned long elapsed = millis() - lastWeatherUpdate;
+  unsigned long interval = currentUpdateInterval();
+  if (lastWeatherUpdate == 0 || elapsed >= interval) {
+    delay(LIGHT_SLEEP_IDLE_STEP); // Cycle due (or waiting for WiFi) - don't hold it up
+    return;
+  }
+  unsigned long remaining = interval - elapsed;
+  // Waits of MINIMUM_SLEEP_TIME and more are deep sleep's - no long-poll for those
+  bool deepSleepWait = DEEP_SLEEP_ENABLED && SLEEP_BETWEEN_UPDATES && remaining >= MINIMUM_SLEEP_TIME;
+  
+  setLightSleepIdle(true);
+  if (COMMAND_LONG_POLL && !deepSleepWait && wifiConnected && isRegistered &&
+      remaining > COMMAND_LONG_POLL_MIN_WAIT) {
+    if (!waitForCommands(min(remaining, (unsigned long)COMMAND_LONG_POLL_WAIT))) {
+      delay(min(remaining, (unsigned long)LIGHT_SLEEP_IDLE_STEP)); // Don't hammer a failing backend
+    }
+  } else {
+    delay(min(remaining, (unsigned long)LIGHT_SLEEP_IDLE_STEP));
+  }
+  setLightSleepIdle(false);
+#else
+  delay(1000); // 1 second delay for power savings
+#endif
+}
+
+// v2.2.0: Command long-poll - the backend holds the request until a command is
+// pending (200, binary command block) or the wait ends (204). Returns false on errors.
+bool waitForCommands(unsigned long waitMs) {
+  HTTPClient http;
+  String url = String(BACKEND_URL) + "/api/v1/devices/" + deviceId +
+               "/commands?format=bin&wait=" + String(waitMs / 1000);
+  
+  beginBackendRequest(http, url);
+  http.setTimeout(waitMs + COMMAND_LONG_POLL_MARGIN);
+  http.addHeader("User-Agent", "WeatherDisplay/2.1.8 ESP32C3-" + deviceId);
+  http.addHeader("X-Command-Ack", String(wakeState.lastCommandId));
+  
+  int httpResponseCode = http.GET();
+  if (httpResponseCode == 200) {
+    uint8_t block[REGION_BINARY_COMMANDS_MAX_SIZE];
+    size_t length = readRegionBinary(http, block, sizeof(block));
+    http.end();
+    
+    DeviceCommandList commands;
+    if (!parseCommandBlock(block, length, commands)) {
+      DEBUG_PRINTLN("Command long-poll: bad command block");
+      return false;
+    }
+    DEBUG_PRINTF("%u command(s) received by long-poll\n", commands.count);
+    if (applyDeviceCommands(commands)) {
+      lastWeatherUpdate = 0; // Poll now for the new region or interval
+    }
+    return true;
+  }
+  http.end();
+  
+  if (httpResponseCode != 204) {
+    DEBUG_PRINTF("Command long-poll failed: HTTP %d\n", httpResponseCode);
+    return false;
+  }
+  return true;
+}
+
+// v2.2.0: No power save while talking to the backend (lowest latency), maximum
+// modem sleep once the cycle's requests are done - the association is kept
+void setModemSleep(bool sleep) {
+#if POWER_PROFILE && MODEM_SLEEP_AFTER_HTTP
+  if (wifiConnected) {
+    WiFi.setSleep(sleep ? WIFI_PS_MAX_MODEM : WIFI_PS_NONE);
+  }
+#endif
+}
+
+// ===============================================================================
+// DISPLAY PIPELINE - v2.2.0
+// ===============================================================================
+
+void startDisplayPipeline() {
+#if PIPELINED_CYCLE && defined(EPAPER_ENABLE)
+  displayQueue = xQueueCreate(1, sizeof(DisplayJob));
+  displayDone = xSemaphoreCreateBinary();
+  
+  if (!displayQueue || !displayDone ||
+      xTaskCreate(displayTask, "display", DISPLAY_TASK_STACK, NULL, 1, NULL) != pdPASS) {
+    DEBUG_PRINTLN("Display task unavailable - using sequential refresh");
+    displayQueue = NULL;
+  }
+#endif
+}
+
+// Returns false when the pipeline is unavailable (caller falls back to refreshDisplay())
+bool queueDisplayRefresh() {
+  if (!displayQueue) return false;
+  
+  static DisplayJob job; // Keep the snapshot off the loop task stack
+  memcpy(job.stations, stations, sizeof(stations));
+  memcpy(job.history, stationHistory, sizeof(stationHistory));
+  job.dataValid = dataValid;
+  
+  xSemaphoreTake(displayDone, 0); // Drop a stale completion so the wait is for this job
+  xQueueOverwrite(displayQueue, &job); // Latest snapshot wins
+  DEBUG_PRINTLN("Display refresh queued - continuing network work");
+  return true;
+}
+
+// Blocks until the display task is done - the panel, frame and SPI bus are
+// shared, so nothing may touch them (or deep sleep) while it still renders
+void waitForDisplayRefresh() {
+  if (xSemaphoreTake(displayDone, pdMS_TO_TICKS(DISPLAY_REFRESH_TIMEOUT)) != pdTRUE) {
+    DEBUG_PRINTLN("WARNING: Display refresh slower than expected - still waiting");
+    xSemaphoreTake(displayDone, portMAX_DELAY);
+  }
+}
+
+void displayTask(void* parameter) {
+  static DisplayJob job;
+  
+  for (;;) {
+    if (xQueueReceive(displayQueue, &job, portMAX_DELAY) == pdTRUE) {
+      // The network side only sends the heartbeat until displayDone is given,
+      // so the render model is owned by this task for the duration
+      memcpy(stations, job.stations, sizeof(stations));
+      memcpy(stationHistory, job.history, sizeof(stationHistory));
+      dataValid = job.dataValid;
+      
+      refreshDisplay();
+      xSemaphoreGive(displayDone);
+    }
+  }
+}
+
 // ===============================================================================
 // MAIN LOOP
 // ===============================================================================
@@ -290,22 +749,69 @@ void loop() {
   if (wifiConnected && shouldUpdateWeather(currentTime)) {
     DEBUG_PRINTLN("=== v2.1.3 COMBINED OPERATION CYCLE ===");
     
+    // v2.2.0: Stayed awake since the last cycle - close its profile now
+    if (wakeState.profileCycleDone) {
+      profileCommitCycle();
+      radioBudgetStart = millis();
+    }
+    
     // Step 1: Monitor WiFi status
     monitorWiFiStatus();
     lastWiFiCheck = currentTime;
     
     // Step 2: Update weather data
+    // v2.2.0: Full clock for the TLS handshake and parse, modem awake for the exchange
     if (wifiConnected) {
+      setModemSleep(false);
+      cpuFullSpeed(true);
       updateWeatherData();
+      cpuFullSpeed(false);
+    }
+    
+    // v2.2.0: Combined mode - that was the cycle's last request, so the modem
+    // sleeps through the panel refresh
+    if (HEARTBEAT_IN_WEATHER_REQUEST) {
+      setModemSleep(true);
+    }
+    
+    // v2.2.0: Hand the parsed data to the display task so the panel refresh
+    // overlaps the heartbeat instead of following it
+    bool displayQueued = needsDisplayUpdate && queueDisplayRefresh();
+    if (displayQueued) {
+      needsDisplayUpdate = false;
     }
     
     // Step 3: Send heartbeat (combined with weather update)
-    if (wifiConnected) {
+    // v2.2.0: In combined mode the telemetry already went out with the weather request
+    // (a full energy trace still needs the POST)
+    if (wifiConnected && ((!HEARTBEAT_IN_WEATHER_REQUEST && telemetryDue()) || energyTraceDue())) {
+      int64_t heartbeatStart = esp_timer_get_time();
+      cpuFullSpeed(true);
       sendHeartbeat();
+      cpuFullSpeed(false);
+      profileRecord(PHASE_HEARTBEAT, heartbeatStart);
       lastHeartbeat = currentTime;
     }
+    setModemSleep(true);
+    
+    if (displayQueued) {
+      waitForDisplayRefresh();
+    }
+    wakeState.profileCycleDone = true;
     
     DEBUG_PRINTLN("=== COMBINED CYCLE COMPLETE - ENTERING SLEEP MODE ===");
+  } else if (!wifiConnected && shouldUpdateWeather(currentTime)) {
+    // v2.2.0: WiFi down when the cycle is due. This wake's first attempt already
+    // ran in setup; staying awake, reconnect once the backoff has elapsed.
+    if (lastWeatherUpdate != 0) {
+      radioBudgetStart = millis();
+      connectToWiFi();
+    }
+    if (!wifiConnected) {
+      noteFetchResult(false); // Starts the stale-data clock
+      scheduleRetry();
+      lastWeatherUpdate = millis();
+    }
   }
   
   // Update display if needed
@@ -328,11 +834,15 @@ void loop() {
   }
   
   // v2.1.3 Power Optimization: Enter deep sleep if enabled
-  if (DEEP_SLEEP_ENABLED && SLEEP_BETWEEN_UPDATES && !identifyRequested && 
-      (currentTime - lastWeatherUpdate < (WEATHER_UPDATE_INTERVAL - 10000))) {
+  // v2.2.0: enterPowerSaveMode() returns when the sleep would be too short - idle instead.
+  // A pending redraw (after identify) goes to the panel before sleeping.
+  // (fresh millis() - this cycle's update ran after currentTime was read)
+  if (DEEP_SLEEP_ENABLED && SLEEP_BETWEEN_UPDATES && !identifyRequested && !needsDisplayUpdate &&
+      (millis() - lastWeatherUpdate < (currentUpdateInterval() - 10000))) {
     enterPowerSaveMode();
-  } else {
-    delay(1000); // 1 second delay for power savings
+  }
+  if (!identifyRequested && !needsDisplayUpdate) {
+    idleUntilNextCycle();
   }
 }
 
@@ -346,6 +856,8 @@ void initializeDisplay() {
   
 #ifdef EPAPER_ENABLE
   epaper.begin();
+  frame.attach(&epaper);
+  DEBUG_PRINTF("Frame buffer: %s\n", frame.direct() ? "direct 1-bpp" : "sprite primitives");
   
   // v2.1.8: No startup screen - just initialize hardware silently
   // Display will only update once when real weather data is available
@@ -363,148 +875,211 @@ void initializeDisplay() {
 
 void refreshDisplay() {
 #ifdef EPAPER_ENABLE
-  Serial.println("Refreshing ePaper display with v2.1.8 WiFi signal bars...");
-  DEBUG_PRINTLN("Refreshing ePaper display with v2.1.8 WiFi signal bars...");
+  bool showData = showWeatherLayout();
+  uint32_t regionHashes[NUM_DISPLAY_REGIONS];
+  computeRegionHashes(regionHashes);
+  uint32_t fingerprint = computeDisplayFingerprint(regionHashes, showData);
+  
+  // v2.2.0: Changed-only policy - skip the panel refresh when the rendered content
+  // is identical, unless the panel was overwritten or the frame is too old
+  // Conserve mode drops the forced refresh and the full-refresh cadence
+  bool conserve = (wakeState.powerMode == POWER_CONSERVE);
+  bool stale = !conserve &&
+               (monotonicMillis() - wakeState.lastDisplayRefreshMs) >= DISPLAY_MAX_STALENESS;
+  if (DISPLAY_CHANGED_ONLY && !forceDisplayRefresh && !stale &&
+      fingerprint == wakeState.displayFingerprint) {
+    DEBUG_PRINTF("Display content unchanged (0x%08lx) - skipping refresh\n", (unsigned long)fingerprint);
+    return;
+  }
+  
+  // v2.2.0: Partial refresh only when the panel already holds the weather layout
+  // and the full-refresh cadence for ghosting control hasn't come round yet
+  bool allowPartial = PARTIAL_REFRESH_ENABLED && !FULL_REFRESH_ALWAYS &&
+                      !forceDisplayRefresh && !stale && showData &&
+                      wakeState.panelShowsData && wakeState.displayFingerprint != 0 &&
+                      (conserve || wakeState.partialRefreshCount < FULL_REFRESH_EVERY_N_CYCLES - 1);
+  forceDisplayRefresh = false;
+  
+  DEBUG_PRINTLN(allowPartial ? "Refreshing ePaper display (partial allowed)..."
+                              : "Refreshing ePaper display (full)...");
   
   // v2.1.8: Ensure display is awake before refresh
   epaper.wake();
   
-  // v2.1.8: Use single anti-ghosting flash for maximum battery life
-  performOptimizedAntiGhosting();
-  
-  // Clear and draw content
-  epaper.fillScreen(TFT_WHITE);
+  // v2.2.0: Anti-ghosting clean only on a full refresh, and only when it is due
+  if (!allowPartial && shouldRunAntiGhostClean()) {
+    int64_t cleanStart = esp_timer_get_time();
+    performOptimizedAntiGhosting();
+    profileRecord(PHASE_PANEL, cleanStart);
+  }
   
-  if (dataValid && wifiConnected) {
-    drawWeatherData();
+  // Clear and draw content - the whole frame is redrawn into the buffer after a
+  // deep sleep, only the transfer to the panel is partial. v2.2.0: While the
+  // buffer still holds the panel's weather frame, only the changed fields are redrawn.
+  int64_t renderStart = esp_timer_get_time();
+  
+  if (showData) {
+    if (!frameHoldsWeather ||
+        !drawChangedFields(epaper, frame, stations, TREND_HISTORY ? stationHistory : NULL,
+                           changedStationFields(regionHashes), changedStationTrends(regionHashes))) {
+      // v2.2.0: Starts from the cached static layer, which replaces the clear
+      drawWeatherData(epaper, frame, stations, TREND_HISTORY ? stationHistory : NULL);
+    }
   } else {
+    frame.fillScreen(TFT_WHITE);
     drawErrorState();
   }
+  frameHoldsWeather = showData;
   
   // Draw status footer with last updated time
-  drawStatusFooter();
+  drawFooter();
+  profileRecord(PHASE_RENDER, renderStart);
   
-  epaper.update();
+  int64_t panelStart = esp_timer_get_time();
+  bool partial = allowPartial && pushDirtyRegions(regionHashes);
+  if (!partial) {
+    epaper.update();
+    wakeState.partialRefreshCount = 0;
+    lastFullRefresh = millis();
+  } else {
+    wakeState.partialRefreshCount++;
+  }
+  profileRecord(PHASE_PANEL, panelStart);
+  wakeState.refreshesSinceClean++;
+  
+  wakeState.displayFingerprint = fingerprint;
+  wakeState.lastDisplayRefreshMs = monotonicMillis();
+  wakeState.panelShowsData = showData;
+  memcpy(wakeState.regionHashes, regionHashes, sizeof(wakeState.regionHashes));
   
   refreshCycle++;
-  Serial.printf("Display refresh complete (cycle %d) - Enhanced display\n", refreshCycle);
+  Serial.printf("Display refresh complete (cycle %d, %s) - Enhanced display\n",
+                refreshCycle, partial ? "partial" : "full");
   DEBUG_PRINTF("v2.1.8 Enhanced display refresh complete (cycle %d)\n", refreshCycle);
 #endif
 }
 
-void performOptimizedAntiGhosting() {
+// v2.2.0: Push the regions whose content changed through the controller's
+// partial window - merged into one bounding window, so the panel runs a single
+// partial waveform (one BUSY wait) however many fields changed. Returns false
+// when a full refresh is the better choice.
+bool pushDirtyRegions(const uint32_t* regionHashes) {
 #ifdef EPAPER_ENABLE
-  Serial.println("*** v2.1.8 BATTERY OPTIMIZED ANTI-GHOSTING ***");
-  DEBUG_PRINTLN("*** v2.1.8 BATTERY OPTIMIZED ANTI-GHOSTING SEQUENCE ***");
-  
-  // v2.1.8: Single flash cycle for maximum battery life (only when data updates)
-  for (int flash = 0; flash < FLASH_CLEAR_CYCLES; flash++) {
-    Serial.printf("Anti-ghosting flash %d/%d (battery optimized)\n", flash + 1, FLASH_CLEAR_CYCLES);
-    DEBUG_PRINTF("Flash cycle %d/%d (battery optimized)\n", flash + 1, FLASH_CLEAR_CYCLES);
+  int dirtyCount = 0;
+  int x0 = DISPLAY_WIDTH, y0 = DISPLAY_HEIGHT, x1 = 0, y1 = 0;
+  for (int r = 0; r < NUM_DISPLAY_REGIONS; r++) {
+    if (regionHashes[r] == wakeState.regionHashes[r]) continue;
+    dirtyCount++;
     
-    // Single BLACK flash
-    epaper.fillScreen(TFT_BLACK);
-    epaper.update();
-    delay(ANTI_GHOST_DELAY);
-    
-    // Return to WHITE
-    epaper.fillScreen(TFT_WHITE);
-    epaper.update();
-    delay(ANTI_GHOST_DELAY);
+    LayoutRect rect = displayRegionRect(r);
+    if (rect.w == 0 || rect.h == 0) continue; // Field the layout doesn't show
+    x0 = min(x0, (int)rect.x);
+    y0 = min(y0, (int)rect.y);
+    x1 = max(x1, rect.x + rect.w);
+    y1 = max(y1, rect.y + rect.h);
+  }
+  
+  if (dirtyCount > PARTIAL_REFRESH_MAX_RECTS) {
+    DEBUG_PRINTF("%d dirty regions - using full refresh\n", dirtyCount);
+    return false;
+  }
+  if (x1 <= x0) {
+    return true; // Nothing visible changed
   }
   
-  Serial.println("*** BATTERY OPTIMIZED ANTI-GHOSTING COMPLETE ***");
-  DEBUG_PRINTLN("*** BATTERY OPTIMIZED ANTI-GHOSTING COMPLETE ***");
+  // UC8179 partial windows are byte aligned horizontally
+  x0 &= ~7;
+  x1 = (x1 + 7) & ~7;
+  DEBUG_PRINTF("Partial update of %d region(s): %d,%d %dx%d\n", dirtyCount, x0, y0, x1 - x0, y1 - y0);
+  if (!epaperUpdateWindow(epaper, x0, y0, x1 - x0, y1 - y0, 0)) {
+    DEBUG_PRINTLN("EPaper has no windowed update() - using full refresh");
+    return false;
+  }
+  return true;
+#else
+  return false;
 #endif
 }
 
-void drawWeatherData() {
+// v2.2.0: Bounding box of each dirty region (covers degree symbols drawn above the text baseline)
+LayoutRect displayRegionRect(int region) {
+  if (region < NUM_STATION_REGIONS) {
+    return stationFieldRect(stationLayoutFor(stations), region / FIELDS_PER_STATION, region % FIELDS_PER_STATION);
+  }
+  if (region < REGION_FOOTER_UPDATED) {
+    return stationTrendRect(stationLayoutFor(stations), region - REGION_TREND_FIRST);
+  }
+  
+  if (region == REGION_FOOTER_UPDATED) {
+    return footerFieldRect(FOOTER_UPDATED);
+  }
+  if (region == REGION_FOOTER_STALE) {
+    return footerFieldRect(FOOTER_STALE);
+  }
+  return footerFieldRect(FOOTER_WIFI); // REGION_FOOTER_WIFI
+}
+
+// v2.2.0: Adaptive clean schedule - every K panel refreshes, K shorter when the
+// panel is cold (ePaper ghosting grows at low temperature). Always clean when
+// the panel content is unknown (cold boot).
+bool shouldRunAntiGhostClean() {
+  if (!ANTI_GHOSTING_ENABLED) return false;
+  if (wakeState.displayFingerprint == 0) return true;
+  
+  float chipTemp = temperatureRead(); // ESP32-C3 internal sensor, close enough to panel ambient
+  int interval = (chipTemp < ANTI_GHOST_COLD_THRESHOLD) ? ANTI_GHOST_CLEAN_INTERVAL_COLD
+                                                        : ANTI_GHOST_CLEAN_INTERVAL;
+  
+  DEBUG_PRINTF("Anti-ghost schedule: %d/%d refreshes since clean (%.1f C)\n",
+               wakeState.refreshesSinceClean, interval, chipTemp);
+  return wakeState.refreshesSinceClean >= interval;
+}
+
+void performOptimizedAntiGhosting() {
 #ifdef EPAPER_ENABLE
-  // v2.1.2 Layout: Enhanced typography with GFX Free Fonts
-  epaper.setTextColor(TFT_BLACK);
+  Serial.println("*** v2.2.0 SINGLE-PASS ANTI-GHOSTING ***");
+  DEBUG_PRINTLN("*** v2.2.0 SINGLE-PASS ANTI-GHOSTING SEQUENCE ***");
   
-  // Three columns layout (260px each + margins) - more space without header
-  int colWidth = 260;
-  int colStartX[3] = {10, 275, 540}; // Column start positions
+  // v2.2.0: One inverted (black) pass drives every pixel through a full swing; the
+  // full-refresh waveform of the content update that follows returns it to white,
+  // so the separate white update of the old sequence is not needed
+  frame.fillScreen(TFT_BLACK);
+  epaper.update();
+  delay(ANTI_GHOST_DELAY);
   
-  for (int i = 0; i < 3; i++) {
-    if (i >= 3 || stations[i].stationName.isEmpty()) continue;
-    
-    int x = colStartX[i];
-    int y = 15; // Start from top (v2.1.2 optimized)
-    
-    // v2.1.4: Station name with FreeSansBold 18pt for prominence
-    epaper.setFreeFont(&FreeSansBold18pt7b);
-    epaper.drawString(stations[i].stationName, x, y);
-    
-    // v2.1.4: Add horizontal line under station name for visual separation
-    epaper.drawLine(x, y + 27, x + colWidth - 10, y + 27, TFT_BLACK);
-    
-    y += 40; // Space for line + margin
-    
-    // v2.1.4: Data fields with FreeSans 12pt for readability
-    epaper.setFreeFont(&FreeSans12pt7b);
-    
-    // v2.1.6: Wind direction with enhanced degree symbol (bigger, thicker outline, lower)
-    String windDirText = "Wind Dir: " + String(stations[i].windDirection);
-    epaper.drawString(windDirText, x, y);
-    // Draw degree symbol as bigger, thicker outline circle after the number
-    int textWidth = epaper.textWidth(windDirText);
-    int centerX = x + textWidth + 3;
-    int centerY = y - 4;
-    epaper.drawCircle(centerX, centerY, 3, TFT_BLACK);  // Main circle
-    epaper.drawCircle(centerX, centerY, 2, TFT_BLACK);  // Inner circle for thickness
-    y += 42; // v2.1.3: Increased spacing by 50% (28 → 42px)
-    
-    // v2.1.5: Wind speed with capitalized label
-    float displayWindSpeed = convertWindSpeed(stations[i].windSpeed, stations[i].displayUnit);
-    epaper.drawString("Wind Speed: " + String(displayWindSpeed, 1) + " " + stations[i].displayUnit, x, y);
-    y += 42; // v2.1.3: Increased spacing by 50%
-    
-    // v2.1.5: Wind gust with capitalized label and proper null handling
-    String gustDisplay;
-    if (isnan(stations[i].windGust)) {
-      gustDisplay = "Wind Gust: --"; // v2.1.5: Capitalized with simplified null display
-    } else {
-      float displayWindGust = convertWindSpeed(stations[i].windGust, stations[i].displayUnit);
-      gustDisplay = "Wind Gust: " + String(displayWindGust, 1) + " " + stations[i].displayUnit;
-    }
-    epaper.drawString(gustDisplay, x, y);
-    y += 42; // v2.1.3: Increased spacing by 50%
-    
-    // v2.1.6: Temperature with enhanced degree symbol (bigger, thicker outline, lower)
-    String tempDisplay;
-    String tempValue;
-    if (isnan(stations[i].temperature)) {
-      tempValue = "--";
-    } else {
-      tempValue = String(stations[i].temperature, 1);
-    }
-    tempDisplay = "Air Temp: " + tempValue;
-    epaper.drawString(tempDisplay, x, y);
-    // Draw degree symbol as bigger, thicker outline circle after the temperature value
-    int tempTextWidth = epaper.textWidth(tempDisplay);
-    int tempCenterX = x + tempTextWidth + 3;
-    int tempCenterY = y - 4;
-    epaper.drawCircle(tempCenterX, tempCenterY, 3, TFT_BLACK);  // Main circle
-    epaper.drawCircle(tempCenterX, tempCenterY, 2, TFT_BLACK);  // Inner circle for thickness
-    // Draw 'C' after degree symbol
-    epaper.drawString("C", x + tempTextWidth + 8, y);
-    y += 42; // v2.1.3: Final field spacing
-    
-    // v2.1.0: No individual update times - moved to footer
-    
-    // Draw vertical separator line (except after last column)
-    if (i < 2) {
-      epaper.drawLine(x + colWidth, 10, x + colWidth, 430, TFT_BLACK);
-    }
-  }
+  wakeState.refreshesSinceClean = 0;
+  frameHoldsWeather = false;
   
-  // v2.1.2: Horizontal line much closer to footer
-  epaper.drawLine(10, 440, 790, 440, TFT_BLACK);
+  Serial.println("*** SINGLE-PASS ANTI-GHOSTING COMPLETE ***");
+  DEBUG_PRINTLN("*** SINGLE-PASS ANTI-GHOSTING COMPLETE ***");
 #endif
 }
 
+void footerUpdatedText(char* buffer, size_t size) {
+  snprintf(buffer, size, "Updated: %s",
+           stations[0].lastUpdateTime[0] == '\0' ? "--:--" : stations[0].lastUpdateTime);
+}
+
+// v2.2.0: "STALE 12m" - minutes since the shown data was last confirmed ("" = current)
+void staleMarkerText(char* buffer, size_t size) {
+  if ((dataValid && wifiConnected) || wakeState.lastGoodDataMs == 0) {
+    buffer[0] = '\0';
+    return;
+  }
+  snprintf(buffer, size, "STALE %lum",
+           (unsigned long)((monotonicMillis() - wakeState.lastGoodDataMs) / 60000));
+}
+
+// v2.2.0: A failed fetch or WiFi drop keeps the last-known-good data on screen
+// (marked stale) until the failures have lasted ERROR_RECOVERY_TIMEOUT
+bool showWeatherLayout() {
+  if (dataValid && wifiConnected) return true;
+  if (wakeState.lastGoodDataMs == 0 || stations[0].stationName[0] == '\0') return false;
+  
+  return wakeState.failingSinceMs == 0 ||
+         (monotonicMillis() - wakeState.failingSinceMs) < ERROR_RECOVERY_TIMEOUT;
+}
+
 void drawErrorState() {
 #ifdef EPAPER_ENABLE
   epaper.setTextSize(3);
@@ -525,70 +1100,67 @@ void drawErrorState() {
 #endif
 }
 
-// v2.1.8: WiFi signal strength indicator using vertical bars
-void drawWiFiSignalBars(int x, int y) {
+// v2.2.0: Final frame before critical-battery sleep (stays on the panel unpowered)
+void drawLowBatteryScreen() {
 #ifdef EPAPER_ENABLE
-  if (!wifiConnected) {
-    // Draw "X" for disconnected WiFi
-    epaper.drawLine(x, y, x + 6, y - 6, TFT_BLACK);
-    epaper.drawLine(x + 6, y, x, y - 6, TFT_BLACK);
-    return;
-  }
+  char voltage[16];
+  formatTenths(voltage, sizeof(voltage), (wakeState.batteryMv + 50) / 100);
   
-  // Convert dBm to signal strength (0-4 bars)
-  int rssi = WiFi.RSSI();
-  int signalBars = 0;
-  if (rssi >= -50) signalBars = 4;      // Excellent
-  else if (rssi >= -60) signalBars = 3; // Good  
-  else if (rssi >= -70) signalBars = 2; // Fair
-  else if (rssi >= -80) signalBars = 1; // Weak
-  else signalBars = 0;                  // Very weak
-  
-  // Draw 4 vertical bars with increasing heights
-  int barWidth = 2;
-  int barSpacing = 1;
-  int maxHeight = 8;
-  
-  for (int i = 0; i < 4; i++) {
-    int barHeight = (i + 1) * (maxHeight / 4); // Heights: 2, 4, 6, 8
-    int barX = x + i * (barWidth + barSpacing);
-    
-    if (i < signalBars) {
-      // Draw filled bar for active signal
-      epaper.fillRect(barX, y - barHeight, barWidth, barHeight, TFT_BLACK);
-    } else {
-      // Draw outline bar for inactive signal
-      epaper.drawRect(barX, y - barHeight, barWidth, barHeight, TFT_BLACK);
-    }
-  }
+  epaper.setTextSize(3);
+  epaper.setTextColor(TFT_BLACK);
+  epaper.drawString("LOW BATTERY", 10, 60);
+  
+  epaper.setTextSize(2);
+  epaper.drawString("Updates paused - please charge", 10, 120);
+  epaper.drawString(String("Battery: ") + voltage + "V", 10, 160);
+  
+  epaper.setTextSize(1);
+  epaper.drawString("ID:" + deviceId.substring(0, 6), 10, 460);
 #endif
 }
 
-void drawStatusFooter() {
+// v2.1.8: WiFi signal strength indicator using vertical bars
+// Convert dBm to signal strength (0-4 bars)
+int wifiSignalBars() {
+  int rssi = WiFi.RSSI();
+  if (rssi >= -50) return 4;      // Excellent
+  if (rssi >= -60) return 3;      // Good
+  if (rssi >= -70) return 2;      // Fair
+  if (rssi >= -80) return 1;      // Weak
+  return 0;                       // Very weak
+}
+
+// v2.2.0: Footer texts from the sketch state, drawn by weather_layout
+void drawFooter() {
 #ifdef EPAPER_ENABLE
-  // v2.1.3: Revert footer to bitmap font for better fit
-  epaper.setFreeFont(); // Reset to default bitmap font
-  epaper.setTextSize(1);
-  
   // v2.1.0: Last Updated time (applies to all 3 stations)
-  String lastUpdated = "Updated: " + (stations[0].lastUpdateTime.isEmpty() ? "--:--" : stations[0].lastUpdateTime);
+  char lastUpdated[FIELD_TEXT_SIZE];
+  footerUpdatedText(lastUpdated, sizeof(lastUpdated));
   
   // Memory as percentage (total heap ~300KB for ESP32C3)
   int freeHeap = ESP.getFreeHeap();
   int totalHeap = 300000; // Approximate total heap for ESP32C3
   int memoryPercent = (freeHeap * 100) / totalHeap;
-  String memoryStatus = "Mem:" + String(memoryPercent) + "%";
+  char memoryStatus[16];
+  
+  // v2.2.0: Battery level replaces Mem% when a battery is sensed
+  if (wakeState.batteryMv != 0) {
+    snprintf(memoryStatus, sizeof(memoryStatus), "Bat:%d%%%s", batteryPercent(),
+             wakeState.powerMode == POWER_CONSERVE ? " LOW" : "");
+  } else {
+    snprintf(memoryStatus, sizeof(memoryStatus), "Mem:%d%%", memoryPercent);
+  }
   
   // Device ID (first 6 characters)
-  String shortId = "ID:" + deviceId.substring(0, 6);
+  char shortId[16];
+  snprintf(shortId, sizeof(shortId), "ID:%.6s", deviceId.c_str());
+  
+  char staleMarker[FIELD_TEXT_SIZE];
+  staleMarkerText(staleMarker, sizeof(staleMarker));
   
-  // v2.1.8 Footer layout: WiFi label + signal bars for best clarity
-  epaper.drawString(lastUpdated, 10, 460);  // v2.1.8: Bitmap font, bottom positioned
-  epaper.drawString("WiFi:", 150, 460);     // v2.1.8: WiFi label
-  drawWiFiSignalBars(185, 468);             // v2.1.8: Visual WiFi signal bars (moved right for better spacing)
-  epaper.drawString(memoryStatus, 210, 460);
-  epaper.drawString(shortId, 320, 460);
-  epaper.drawString("v2.1.8", 420, 460);
+  FooterStatus status = {lastUpdated, wifiConnected ? wifiSignalBars() : -1,
+                         memoryStatus, shortId, staleMarker};
+  drawStatusFooter(epaper, frame, status);
 #endif
 }
 
@@ -598,16 +1170,25 @@ void performIdentifySequence() {
   DEBUG_PRINTLN("Performing minimal identify sequence...");
   
   // v2.1.0: Single flash for minimal disruption
-  epaper.fillScreen(TFT_BLACK);
+  frame.fillScreen(TFT_BLACK);
   epaper.update();
   delay(300);
   
-  epaper.fillScreen(TFT_WHITE);
+  frame.fillScreen(TFT_WHITE);
   epaper.update();
   delay(300);
   
   // Restore normal display
   needsDisplayUpdate = true;
+  forceDisplayRefresh = true; // v2.2.0: Panel no longer shows the fingerprinted frame
+  frameHoldsWeather = false;
+  wakeState.refreshesSinceClean = 0; // v2.2.0: Black/white flash doubles as a clean
+  
+  // v2.2.0: The panel is blank - a warm wake must redraw the whole frame
+  wakeState.displayFingerprint = 0;
+  wakeState.panelShowsData = false;
+  wakeState.partialRefreshCount = 0;
+  memset(wakeState.regionHashes, 0, sizeof(wakeState.regionHashes));
   
   Serial.println("*** IDENTIFY SEQUENCE COMPLETE ***");
   DEBUG_PRINTLN("Minimal identify sequence complete");
@@ -622,47 +1203,47 @@ void initializeWiFi() {
   DEBUG_PRINTLN("Initializing WiFi...");
   
   WiFi.mode(WIFI_STA);
+  radioBudgetStart = millis();
   
   // Try to connect to known networks
   connectToWiFi();
 }
 
+// v2.2.0: Timed for the phase profiler (includes reconnects from monitorWiFiStatus)
 void connectToWiFi() {
+  int64_t wifiStart = esp_timer_get_time();
+  connectToKnownNetwork();
+  profileRecord(PHASE_WIFI, wifiStart);
+}
+
+void connectToKnownNetwork() {
+#if WIFI_FAST_CONNECT
+  // v2.2.0: Try the cached access point first - no scan, no DHCP round trip
+  if (fastConnectToWiFi()) {
+    return;
+  }
+#endif
+  
   DEBUG_PRINTLN("Scanning for known networks...");
   
+  // Fall back to static IP from secrets.h or plain DHCP for a fresh association
+  applyWiFiIpConfig(false);
+  
   int numNetworks = WiFi.scanNetworks();
   DEBUG_PRINTF("Found %d networks\n", numNetworks);
   
   // Try each configured network
+  // v2.2.0: Short per-network timeout, and no further attempts once the cycle's radio budget is spent
   for (int i = 0; i < NUM_WIFI_NETWORKS; i++) {
-    for (int j = 0; j < numNetworks; j++) {
+    for (int j = 0; j < numNetworks && radioBudgetLeft() > 0; j++) {
       if (WiFi.SSID(j) == WIFI_NETWORKS[i].ssid) {
         DEBUG_PRINTF("Connecting to %s...\n", WIFI_NETWORKS[i].ssid);
         
         WiFi.begin(WIFI_NETWORKS[i].ssid, WIFI_NETWORKS[i].password);
         
-        int timeout = 0;
-        while (WiFi.status() != WL_CONNECTED && timeout < 30) {
-          delay(1000);
-          timeout++;
-          Serial.print(".");
-        }
-        
-        if (WiFi.status() == WL_CONNECTED) {
-          wifiConnected = true;
-          wifiReconnectAttempts = 0;
-          
-          // Enhanced WiFi connection info
-          Serial.println("\n*** WiFi Connection Successful ***");
-          Serial.printf("SSID: %s\n", WiFi.SSID().c_str());
-          Serial.printf("IP Address: %s\n", WiFi.localIP().toString().c_str());
-          Serial.printf("Signal Strength: %d dBm\n", WiFi.RSSI());
-          Serial.printf("Gateway: %s\n", WiFi.gatewayIP().toString().c_str());
-          Serial.printf("DNS: %s\n", WiFi.dnsIP().toString().c_str());
-          Serial.println("********************************");
-          
-          DEBUG_PRINTF("\nConnected! IP: %s\n", WiFi.localIP().toString().c_str());
-          needsDisplayUpdate = true;
+        if (waitForWiFiConnection(min(radioBudgetLeft(), (unsigned long)WIFI_SCAN_CONNECT_TIMEOUT))) {
+          onWiFiConnected(i);
+          WiFi.scanDelete();
           return;
         } else {
           DEBUG_PRINTLN("\nConnection failed");
@@ -671,12 +1252,108 @@ void connectToWiFi() {
     }
   }
   
+  WiFi.scanDelete();
   wifiConnected = false;
   wifiReconnectAttempts++;
   DEBUG_PRINTLN("No known networks found");
   needsDisplayUpdate = true;
 }
 
+// v2.2.0: Reconnect to the last access point by BSSID/channel, skipping the scan
+bool fastConnectToWiFi() {
+  int index = wakeState.wifiNetworkIndex;
+  if (index < 0 || index >= NUM_WIFI_NETWORKS || wakeState.wifiChannel <= 0) {
+    return false;
+  }
+  
+  DEBUG_PRINTF("Fast connect to %s (channel %d)...\n",
+               WIFI_NETWORKS[index].ssid, (int)wakeState.wifiChannel);
+  
+  applyWiFiIpConfig(true);
+  WiFi.begin(WIFI_NETWORKS[index].ssid, WIFI_NETWORKS[index].password,
+             wakeState.wifiChannel, wakeState.wifiBssid, true);
+  
+  if (waitForWiFiConnection(WIFI_FAST_CONNECT_TIMEOUT)) {
+    onWiFiConnected(index);
+    return true;
+  }
+  
+  DEBUG_PRINTLN("\nFast connect failed - falling back to scan");
+  WiFi.disconnect();
+  invalidateWiFiCache();
+  return false;
+}
+
+// v2.2.0: Static IP from secrets.h wins; otherwise reuse the cached lease on fast connect
+void applyWiFiIpConfig(bool reuseLease) {
+#ifdef WIFI_STATIC_IP
+  IPAddress ip, gateway, subnet, dns;
+  ip.fromString(WIFI_STATIC_IP);
+  gateway.fromString(WIFI_STATIC_GATEWAY);
+  subnet.fromString(WIFI_STATIC_SUBNET);
+  dns.fromString(WIFI_STATIC_DNS);
+  WiFi.config(ip, gateway, subnet, dns);
+#else
+  if (WIFI_REUSE_DHCP_LEASE && reuseLease && wakeState.wifiIp != 0) {
+    DEBUG_PRINTF("Reusing DHCP lease %s\n", IPAddress(wakeState.wifiIp).toString().c_str());
+    WiFi.config(IPAddress(wakeState.wifiIp), IPAddress(wakeState.wifiGateway),
+                IPAddress(wakeState.wifiSubnet), IPAddress(wakeState.wifiDns));
+  } else {
+    WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE); // Back to DHCP
+  }
+#endif
+}
+
+// v2.2.0: Short polling steps instead of whole-second delays
+bool waitForWiFiConnection(unsigned long timeoutMs) {
+  unsigned long start = millis();
+  unsigned long lastDot = start;
+  
+  while (WiFi.status() != WL_CONNECTED && millis() - start < timeoutMs) {
+    delay(WIFI_POLL_INTERVAL);
+    if (millis() - lastDot >= 1000) {
+      Serial.print(".");
+      lastDot = millis();
+    }
+  }
+  
+  return WiFi.status() == WL_CONNECTED;
+}
+
+void onWiFiConnected(int networkIndex) {
+  wifiConnected = true;
+  wifiReconnectAttempts = 0;
+  
+  // Enhanced WiFi connection info
+  Serial.println("\n*** WiFi Connection Successful ***");
+  Serial.printf("SSID: %s\n", WiFi.SSID().c_str());
+  Serial.printf("IP Address: %s\n", WiFi.localIP().toString().c_str());
+  Serial.printf("Signal Strength: %d dBm\n", WiFi.RSSI());
+  Serial.printf("Gateway: %s\n", WiFi.gatewayIP().toString().c_str());
+  Serial.printf("DNS: %s\n", WiFi.dnsIP().toString().c_str());
+  Serial.println("********************************");
+  
+  DEBUG_PRINTF("\nConnected! IP: %s\n", WiFi.localIP().toString().c_str());
+  
+  // v2.2.0: Remember the access point and lease for the next wake
+  wakeState.wifiNetworkIndex = networkIndex;
+  memcpy(wakeState.wifiBssid, WiFi.BSSID(), sizeof(wakeState.wifiBssid));
+  wakeState.wifiChannel = WiFi.channel();
+  wakeState.wifiIp = (uint32_t)WiFi.localIP();
+  wakeState.wifiGateway = (uint32_t)WiFi.gatewayIP();
+  wakeState.wifiSubnet = (uint32_t)WiFi.subnetMask();
+  wakeState.wifiDns = (uint32_t)WiFi.dnsIP();
+  
+  needsDisplayUpdate = true;
+}
+
+// v2.2.0: Forget the cached access point and lease so the next connect scans and uses DHCP
+void invalidateWiFiCache() {
+  wakeState.wifiNetworkIndex = -1;
+  wakeState.wifiChannel = 0;
+  wakeState.wifiIp = 0;
+}
+
 void monitorWiFiStatus() {
   bool previousStatus = wifiConnected;
   wifiConnected = (WiFi.status() == WL_CONNECTED);
@@ -687,7 +1364,7 @@ void monitorWiFiStatus() {
     
     if (!wifiConnected) {
       // Try to reconnect
-      if (wifiReconnectAttempts < MAX_WIFI_RECONNECT_ATTEMPTS) {
+      if (wifiReconnectAttempts < MAX_WIFI_RECONNECT_ATTEMPTS && radioBudgetLeft() > 0) {
         DEBUG_PRINTLN("Attempting WiFi reconnection...");
         connectToWiFi();
       }
@@ -702,7 +1379,7 @@ void monitorWiFiStatus() {
 // ===============================================================================
 
 bool shouldUpdateWeather(unsigned long currentTime) {
-  return (currentTime - lastWeatherUpdate > WEATHER_UPDATE_INTERVAL) ||
+  return (currentTime - lastWeatherUpdate > currentUpdateInterval()) ||
          (lastWeatherUpdate == 0);
 }
 
@@ -718,21 +1395,104 @@ void updateWeatherData() {
   HTTPClient http;
   String url = String(BACKEND_URL) + "/api/v1/weather/region/" + currentRegionId + 
                "?mac=" + deviceId;
+#if BINARY_REGION_PAYLOAD
+  url += "&format=bin";
+#if REGION_DELTA_UPDATES
+  url += "&delta=1"; // v2.2.0: Only the changed fields, against the version in If-None-Match
+#endif
+#endif
   
-  http.begin(url);
-  http.addHeader("User-Agent", "WeatherDisplay/2.1.8 ESP32C3-" + deviceId); // v2.1.8: Updated version
-  http.addHeader("X-Device-MAC", deviceMAC);
-  
-  int httpResponseCode = http.GET();
+  // v2.2.0: Transient failures retry within the cycle's radio budget
+  int httpResponseCode;
+  for (int attempt = 0; ; attempt++) {
+    beginWeatherRequest(http, url);
+    int64_t requestStart = esp_timer_get_time();
+    httpResponseCode = http.GET();
+    profileRecordRequest(requestStart);
+    
+    if (!httpRetryable(httpResponseCode) || !waitForHttpRetry(attempt)) break;
+    http.end();
+  }
+  int64_t parseStart = esp_timer_get_time();
+  storePollHint(http.header("X-Next-Poll"));
+  
+  if (httpResponseCode == 304) {
+    // Nothing changed upstream - keep the restored data and frame
+    DEBUG_PRINTLN("Weather not modified (304) - skipping parse and refresh");
+    scheduleNextUpdate(false);
+    noteFetchResult(true);
+    recordStationHistory();
+    lastError = "";
+    http.end();
+    lastWeatherUpdate = millis();
+    return;
+  }
   
   if (httpResponseCode == 200) {
-    String payload = http.getString();
-    if (parseRegionWeatherResponse(payload)) {
+    storeETag(http.header("ETag"));
+    
+    // v2.2.0: Binary body goes into a fixed stack buffer; an older backend that
+    // ignores ?format=bin still answers JSON
+    uint8_t binaryPayload[REGION_BINARY_MAX_SIZE];
+    size_t binaryLength = 0;
+    StaticJsonDocument<REGION_JSON_DOC_SIZE> doc;
+    DeserializationError jsonError;
+    bool binary = http.header("Content-Type").startsWith(REGION_BINARY_CONTENT_TYPE);
+    uint32_t payloadHash;
+    bool hasActions;
+    if (binary) {
+      binaryLength = readRegionBinary(http, binaryPayload, sizeof(binaryPayload));
+      payloadHash = fnv1aHash((const char*)binaryPayload, binaryLength);
+      hasActions = regionBinaryHasActions(binaryPayload, binaryLength);
+    } else {
+      jsonError = readRegionJson(http.getStream(), doc);
+      if (jsonError) {
+        DEBUG_PRINTF("JSON parse error: %s\n", jsonError.c_str());
+      }
+      payloadHash = regionJsonHash(doc);
+      hasActions = !jsonError && regionJsonHasActions(doc);
+    }
+    
+    // v2.2.0: Identical payload to the last cycle - keep the restored data and frame.
+    // A payload with an identify request or commands is always applied: a
+    // re-sent command means the earlier copy's effect may have been lost.
+    if (dataValid && !hasActions && payloadHash == wakeState.payloadHash) {
+      profileRecord(PHASE_PARSE, parseStart);
+      scheduleNextUpdate(false);
+      noteFetchResult(true);
+      recordStationHistory();
+      DEBUG_PRINTLN("Weather payload unchanged since last cycle - skipping parse");
+      http.end();
+      lastWeatherUpdate = millis();
+      return;
+    }
+    StationData previous[STATION_SLOTS];
+    memcpy(previous, stations, sizeof(stations));
+    
+    RegionHeader region = {};
+    bool parsed = binary ? parseRegionBinary(binaryPayload, binaryLength, region, stations)
+                         : (!jsonError && parseRegionJson(doc, region, stations));
+    if (parsed) {
+      if (region.delta) {
+        DEBUG_PRINTF("Delta payload merged (%u bytes)\n", (unsigned)binaryLength);
+      }
+      applyRegionHeader(region);
+      applyDeviceCommands(region.commands); // This response already carries the new X-Next-Poll
+    }
+    wakeState.payloadHash = parsed ? payloadHash : 0; // Only a payload that was applied counts as seen
+    profileRecord(PHASE_PARSE, parseStart);
+    wakeState.windActive = parsed && stationsWindActive(previous);
+    scheduleNextUpdate(true);
+    noteFetchResult(parsed);
+    if (parsed) {
       dataValid = true;
       lastError = "";
+      recordStationHistory();
       DEBUG_PRINTLN("Weather data updated successfully");
     } else {
+      memcpy(stations, previous, sizeof(stations)); // v2.2.0: Keep the last-known-good data
       dataValid = false;
+      wakeState.etag[0] = '\0';
       lastError = "Parse Error";
       DEBUG_PRINTLN("Failed to parse weather data");
     }
@@ -742,6 +1502,13 @@ void updateWeatherData() {
     String payload = http.getString();
     handleNewDeviceResponse(payload);
   } else {
+    // v2.2.0: Connection-level failure may mean a stale reused lease - renew via DHCP next time
+    if (httpResponseCode < 0) {
+      wakeState.wifiIp = 0;
+    }
+    
+    scheduleRetry(); // v2.2.0: Backs off across cycles
+    noteFetchResult(false);
     dataValid = false;
     lastError = "HTTP " + String(httpResponseCode);
     lastErrorTime = millis();
@@ -753,106 +1520,244 @@ void updateWeatherData() {
   lastWeatherUpdate = millis();
 }
 
-// New region weather response parser for 3-station data
-bool parseRegionWeatherResponse(const String& jsonString) {
-  DynamicJsonDocument doc(4096); // Larger buffer for 3 stations
-  DeserializationError error = deserializeJson(doc, jsonString);
+void beginWeatherRequest(HTTPClient& http, const String& url) {
+  beginBackendRequest(http, url);
+  http.useHTTP10(true); // v2.2.0: No chunked encoding, so the JSON body can be parsed from the raw stream
+  http.addHeader("User-Agent", "WeatherDisplay/2.1.8 ESP32C3-" + deviceId); // v2.1.8: Updated version
+  http.addHeader("X-Device-MAC", deviceMAC);
+  http.addHeader("X-Firmware-Version", DEVICE_FIRMWARE_VERSION);
+  http.addHeader("X-Command-Ack", String(wakeState.lastCommandId)); // v2.2.0: Also opts in to commands
+  if (telemetryDue()) {
+    http.addHeader("X-Device-Telemetry", buildTelemetryHeader()); // v2.2.0: Combined heartbeat
+  }
   
-  if (error) {
-    DEBUG_PRINTF("JSON parse error: %s\n", error.c_str());
+  // v2.2.0: Conditional GET - only when the data the ETag describes is still on hand
+  const char* responseHeaders[] = {"ETag", "Content-Type", "X-Next-Poll"};
+  http.collectHeaders(responseHeaders, 3);
+  if (dataValid && wakeState.etag[0] != '\0') {
+    http.addHeader("If-None-Match", wakeState.etag);
+  }
+}
+
+// ===============================================================================
+// RETRY POLICY - v2.2.0
+// ===============================================================================
+
+// Radio-on time left in this cycle (WiFi connect plus backend requests)
+unsigned long radioBudgetLeft() {
+  unsigned long used = millis() - radioBudgetStart;
+  return (used < RADIO_BUDGET_PER_CYCLE) ? RADIO_BUDGET_PER_CYCLE - used : 0;
+}
+
+// +/- RETRY_JITTER_PERCENT, so units that lost the same AP don't retry in lockstep
+unsigned long withJitter(unsigned long ms) {
+  unsigned long spread = ms / 100 * RETRY_JITTER_PERCENT;
+  return ms - spread + (spread ? random(2 * spread + 1) : 0);
+}
+
+// Connection-level errors and server errors are worth another try; 4xx are not
+bool httpRetryable(int httpResponseCode) {
+  return httpResponseCode < 0 || httpResponseCode >= 500;
+}
+
+// HTTP_RETRY_DELAY doubling per attempt, up to MAX_HTTP_RETRIES attempts in all.
+// Returns false (no wait) when another attempt wouldn't fit the radio budget.
+bool waitForHttpRetry(int attempt) {
+  if (attempt + 1 >= MAX_HTTP_RETRIES) return false;
+  
+  unsigned long wait = withJitter((unsigned long)HTTP_RETRY_DELAY << attempt);
+  if (radioBudgetLeft() < wait + HTTP_CONNECT_TIMEOUT) {
+    DEBUG_PRINTLN("Radio budget spent - no further HTTP retries this cycle");
     return false;
   }
   
-  // Extract region info
-  currentRegionId = doc["regionId"].as<String>();
-  regionDisplayName = doc["regionName"].as<String>();
-  currentDate = doc["timestamp"].as<String>();
+  DEBUG_PRINTF("HTTP retry %d/%d in %lums\n", attempt + 1, MAX_HTTP_RETRIES - 1, wait);
+  delay(wait);
+  return true;
+}
+
+// Cycle without a backend response: the normal schedule interval, doubling per
+// failed cycle up to RETRY_BACKOFF_MAX - apart from the jitter, an outage never
+// makes the device wake more often than it would have. The streak lives in RTC memory, so an access
+// point that stays down costs one short attempt per hour instead of a scan every cycle.
+void scheduleRetry() {
+  if (wakeState.failureStreak < 255) {
+    wakeState.failureStreak++;
+  }
   
-  // Parse current date to "DD MMM YYYY" format
-  if (currentDate.length() >= 10) {
-    String year = currentDate.substring(0, 4);
-    String month = currentDate.substring(5, 7);
-    String day = currentDate.substring(8, 10);
-    
-    String monthNames[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
-                          "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
-    int monthNum = month.toInt() - 1;
-    if (monthNum >= 0 && monthNum < 12) {
-      currentDate = day + " " + monthNames[monthNum] + " " + year;
-    }
+  uint32_t steps = min((uint32_t)wakeState.failureStreak - 1, (uint32_t)16);
+  uint32_t base = scheduledInterval();
+  uint32_t interval = (uint32_t)min((uint64_t)base << steps, (uint64_t)RETRY_BACKOFF_MAX);
+  wakeState.updateIntervalMs = withJitter(interval);
+  DEBUG_PRINTF("Failure %u in a row - retrying in %lus\n", wakeState.failureStreak,
+               (unsigned long)(wakeState.updateIntervalMs / 1000));
+}
+
+// ===============================================================================
+// UPDATE SCHEDULER - v2.2.0
+// ===============================================================================
+
+// Interval from the last weather update to the next combined cycle
+unsigned long currentUpdateInterval() {
+  unsigned long interval = wakeState.updateIntervalMs ? wakeState.updateIntervalMs : WEATHER_UPDATE_INTERVAL;
+  if (wakeState.powerMode == POWER_CONSERVE) {
+    interval = min(interval * CONSERVE_INTERVAL_FACTOR, (unsigned long)SCHEDULE_MAX_INTERVAL);
+  }
+  return interval;
+}
+
+// Backend hint (X-Next-Poll, seconds) replaces the base interval while present
+void storePollHint(const String& header) {
+  long seconds = header.toInt();
+  wakeState.pollHintS = (seconds > 0) ? (uint16_t)min(seconds, 65535L) : 0;
+}
+
+// Base interval (backend hint or WEATHER_UPDATE_INTERVAL), stretched per unchanged
+// cycle, capped while the wind is active, then clamped to the schedule limits
+uint32_t scheduledInterval() {
+#if ADAPTIVE_SCHEDULE
+  uint32_t interval = wakeState.pollHintS ? wakeState.pollHintS * 1000UL : WEATHER_UPDATE_INTERVAL;
+  uint32_t steps = min((uint32_t)wakeState.unchangedStreak, (uint32_t)SCHEDULE_MAX_STRETCH_STEPS);
+  interval += interval / 100 * SCHEDULE_UNCHANGED_STRETCH * steps;
+  
+  if (wakeState.windActive) {
+    interval = min(interval, (uint32_t)SCHEDULE_ACTIVE_INTERVAL);
   }
   
-  // Parse stations array (should be 3 stations)
-  JsonArray stationsArray = doc["stations"];
-  int stationCount = min((int)stationsArray.size(), 3);
+  return constrain(interval, (uint32_t)SCHEDULE_MIN_INTERVAL, (uint32_t)SCHEDULE_MAX_INTERVAL);
+#else
+  return WEATHER_UPDATE_INTERVAL;
+#endif
+}
+
+void scheduleNextUpdate(bool dataChanged) {
+#if ADAPTIVE_SCHEDULE
+  if (dataChanged) {
+    wakeState.unchangedStreak = 0;
+  } else if (wakeState.unchangedStreak < 255) {
+    wakeState.unchangedStreak++;
+  }
   
-  for (int i = 0; i < stationCount; i++) {
-    JsonObject station = stationsArray[i];
-    
-    stations[i].stationName = station["stationId"].as<String>();
-    
-    // Clean up station names for display (v2.1.6: Fixed accent character)
-    if (stations[i].stationName == "prarion") stations[i].stationName = "Prarion";
-    else if (stations[i].stationName == "planpraz") stations[i].stationName = "Planpraz";
-    else if (stations[i].stationName == "tetedebalme") stations[i].stationName = "Tete de Balme"; // v2.1.6: Fixed ê → e
-    else if (stations[i].stationName == "brambles") stations[i].stationName = "Brambles";
-    else if (stations[i].stationName == "seaview") stations[i].stationName = "Seaview";
-    else if (stations[i].stationName == "lymington") stations[i].stationName = "Lymington";
-    
-    // Extract weather data with proper null handling for v2.0.0 backend
-    JsonObject weatherData = station["data"];
-    JsonObject tempData = weatherData["temperature"];
-    JsonObject windData = weatherData["wind"];
-    
-    // Temperature handling - backend v2.0.0 properly returns null for missing data
-    if (tempData.isNull() || tempData["air"].isNull()) {
-      stations[i].temperature = NAN; // Use NAN to indicate missing data
-    } else {
-      float temp = tempData["air"].as<float>();
-      // Validate temperature range (-60°C to +60°C)
-      if (temp >= -60.0 && temp <= 60.0) {
-        stations[i].temperature = temp;
-      } else {
-        stations[i].temperature = NAN; // Invalid temperature
-      }
-    }
-    
-    // Wind speed - backend v2.0.0 always provides in m/s, never null (0 = calm)
-    stations[i].windSpeed = windData["avg"].as<float>();
-    stations[i].windUnit = "m/s"; // Backend v2.0.0 always returns m/s
+  wakeState.updateIntervalMs = scheduledInterval();
+  DEBUG_PRINTF("Next update in %lus (hint %us, unchanged x%u, wind %s)\n",
+               (unsigned long)(wakeState.updateIntervalMs / 1000), wakeState.pollHintS,
+               wakeState.unchangedStreak, wakeState.windActive ? "active" : "steady");
+#else
+  wakeState.updateIntervalMs = 0; // Back to WEATHER_UPDATE_INTERVAL after a retry backoff
+#endif
+}
+
+// Strong gusts, or average wind moving fast since the previous data for the same station
+bool stationsWindActive(const StationData* previous) {
+  for (int i = 0; i < STATION_SLOTS; i++) {
+    if (stations[i].stationName[0] == '\0') continue;
     
-    // Wind gust - backend v2.0.0 returns null for instantaneous-only readings
-    if (windData["gust"].isNull()) {
-      stations[i].windGust = NAN; // Use NAN to indicate no gust data available
-    } else {
-      stations[i].windGust = windData["gust"].as<float>();
+    if (stations[i].windGust != VALUE_MISSING && stations[i].windGust >= SCHEDULE_GUST_THRESHOLD) {
+      return true;
     }
-    
-    // Wind direction - always available from backend
-    stations[i].windDirection = windData["direction"].as<int>();
-    
-    // Set regional display units for user-friendly display
-    if (currentRegionId == "chamonix") {
-      stations[i].displayUnit = "kph"; // Alpine stations: km/h
-    } else {
-      stations[i].displayUnit = "kts"; // Marine stations: knots
+    if (strcmp(stations[i].stationName, previous[i].stationName) == 0 &&
+        abs(stations[i].windSpeed - previous[i].windSpeed) >= SCHEDULE_WIND_DELTA) {
+      return true;
     }
+  }
+  return false;
+}
+
+// v2.2.0: Sample the confirmed-current data into each slot's wind trend. Buckets
+// without a confirmation (failed fetches, long sleeps) stay empty. Unchanged data
+// doesn't refresh the panel on its own - the trend catches up with the next change.
+void recordStationHistory() {
+#if TREND_HISTORY
+  uint32_t bucket = (uint32_t)(monotonicMillis() / HISTORY_BUCKET_MS);
+  for (int i = 0; i < STATION_SLOTS; i++) {
+    recordWindHistory(stationHistory[i], stations[i], bucket);
+  }
+#endif
+}
+
+// v2.2.0: Track when data was last confirmed current and how long fetches have failed
+void noteFetchResult(bool ok) {
+  if (ok) {
+    wakeState.lastGoodDataMs = monotonicMillis();
+    wakeState.failingSinceMs = 0;
+    wakeState.failureStreak = 0;
+  } else if (wakeState.failingSinceMs == 0) {
+    wakeState.failingSinceMs = monotonicMillis();
+    DEBUG_PRINTLN("Fetch failed - keeping last-known-good data on screen");
+  }
+}
+
+// v2.2.0: Remember the ETag for the next If-None-Match (dropped if it doesn't fit)
+void storeETag(const String& etag) {
+  if (etag.length() < sizeof(wakeState.etag)) {
+    strncpy(wakeState.etag, etag.c_str(), sizeof(wakeState.etag));
+  } else {
+    wakeState.etag[0] = '\0';
+  }
+}
+
+// v2.2.0: Region-level fields of a parsed payload into the sketch state
+void applyRegionHeader(const RegionHeader& region) {
+  currentRegionId = region.regionId;
+  if (region.regionName[0] != '\0') {
+    regionDisplayName = region.regionName;
+  }
+  if (region.date[0] != '\0') {
+    currentDate = region.date;
+  }
+  if (region.identify) {
+    identifyRequested = true;
+  }
+}
+
+// v2.2.0: Backend commands newer than the last one applied - the backend redelivers
+// each until a request acknowledges it. True when one needs a fresh region poll.
+bool applyDeviceCommands(const DeviceCommandList& commands) {
+  bool pollNow = false;
+  for (int i = 0; i < commands.count; i++) {
+    const DeviceCommand& command = commands.items[i];
+    if (command.id <= wakeState.lastCommandId) continue;
+    wakeState.lastCommandId = command.id;
     
-    // Format timestamp to time only (HH:MM UTC)
-    String timestamp = station["timestamp"].as<String>();
-    if (timestamp.length() >= 16) {
-      stations[i].lastUpdateTime = timestamp.substring(11, 16) + " UTC";
-    } else {
-      stations[i].lastUpdateTime = "--:-- UTC";
+    switch (command.type) {
+      case COMMAND_IDENTIFY:
+        identifyRequested = true;
+        break;
+      case COMMAND_REGION: {
+        const RegionInfo* region = findRegion(command.text);
+        if (!region) {
+          DEBUG_PRINTF("Command %lu: unknown region %s\n", (unsigned long)command.id, command.text);
+          break;
+        }
+        pollNow |= (currentRegionId != command.text); // Already switched when it came with the payload
+        currentRegionId = command.text;
+        regionDisplayName = region->displayName;
+        saveSettings(); // Survives a cold boot, like a registration assignment
+        break;
+      }
+      case COMMAND_INTERVAL:
+        pollNow = true; // The backend sends the new interval as X-Next-Poll
+        break;
+      case COMMAND_REFRESH:
+        forceDisplayRefresh = true;
+        needsDisplayUpdate = true;
+        break;
+      default:
+        break;
     }
+    DEBUG_PRINTF("Command %lu applied (type %u)\n", (unsigned long)command.id, command.type);
   }
-  
-  // Check for identify request
-  if (doc["identify"].as<bool>()) {
-    identifyRequested = true;
+  return pollNow;
+}
+
+// v2.2.0: Read a binary body into a caller buffer; 0 if it is missing or too large
+size_t readRegionBinary(HTTPClient& http, uint8_t* buffer, size_t capacity) {
+  int size = http.getSize();
+  if (size <= 0 || (size_t)size > capacity) {
+    DEBUG_PRINTF("Binary payload size %d not usable\n", size);
+    return 0;
   }
-  
-  return true;
+  return http.getStreamPtr()->readBytes(buffer, size);
 }
 
 // Legacy single station parser (kept for compatibility)
@@ -866,12 +1771,14 @@ bool parseWeatherResponse(const String& jsonString) {
   }
   
   // For backward compatibility - convert to first station
-  stations[0].stationName = doc["stationId"].as<String>();
-  stations[0].temperature = doc["data"]["temperature"]["air"].as<float>();
-  stations[0].windSpeed = doc["data"]["wind"]["avg"].as<float>();
-  stations[0].windGust = doc["data"]["wind"]["gust"].as<float>();
+  strlcpy(stations[0].stationName, doc["stationId"] | "", sizeof(stations[0].stationName));
+  stations[0].temperature = doc["data"]["temperature"]["air"].isNull()
+                              ? VALUE_MISSING : toTenths(doc["data"]["temperature"]["air"].as<float>());
+  stations[0].windSpeed = toTenths(doc["data"]["wind"]["avg"].as<float>());
+  stations[0].windGust = doc["data"]["wind"]["gust"].isNull()
+                           ? VALUE_MISSING : toTenths(doc["data"]["wind"]["gust"].as<float>());
   stations[0].windDirection = doc["data"]["wind"]["direction"].as<int>();
-  stations[0].lastUpdateTime = doc["timestamp"].as<String>();
+  setLastUpdateTime(stations[0], doc["timestamp"] | "", 11);
   
   // Check for identify request
   if (doc["identify"].as<bool>()) {
@@ -895,12 +1802,8 @@ void handleNewDeviceResponse(const String& jsonString) {
       currentRegionId = doc["regionId"].as<String>();
     } else if (doc["stationId"]) {
       // Legacy support - determine region from station
-      String stationId = doc["stationId"].as<String>();
-      if (stationId == "prarion" || stationId == "planpraz" || stationId == "tetedebalme") {
-        currentRegionId = "chamonix";
-      } else {
-        currentRegionId = "solent";
-      }
+      const StationInfo* station = findStation(doc["stationId"] | "");
+      currentRegionId = station ? REGIONS[station->region].id : DEFAULT_REGION;
     }
     
     // Save settings
@@ -921,12 +1824,18 @@ void sendHeartbeat() {
   HTTPClient http;
   String url = String(BACKEND_URL) + "/api/v1/devices/" + deviceId + "/heartbeat";
   
-  http.begin(url);
+  beginBackendRequest(http, url);
   http.addHeader("Content-Type", "application/json");
   http.addHeader("User-Agent", "WeatherDisplay/1.0 ESP32C3-" + deviceId);
+  http.addHeader("X-Firmware-Version", DEVICE_FIRMWARE_VERSION);
+  http.addHeader("X-Device-Telemetry", buildTelemetryHeader());
   
   String payload = "{\"deviceId\":\"" + deviceId + "\",\"timestamp\":\"" + 
-                   String(millis()) + "\"}";
+                   String(millis()) + "\"";
+  if (energyTraceDue()) {
+    payload += ",\"trace\":" + buildEnergyTrace(); // v2.2.0: Whole RTC ring
+  }
+  payload += "}";
   
   int httpResponseCode = http.POST(payload);
   
@@ -940,10 +1849,385 @@ void sendHeartbeat() {
   lastHeartbeat = millis();
 }
 
+// v2.2.0: Route backend requests through the resumable TLS client. Connection
+// reuse is off so http.end() closes the socket and the session gets saved.
+bool beginBackendRequest(HTTPClient& http, const String& url) {
+  http.setConnectTimeout(HTTP_CONNECT_TIMEOUT); // v2.2.0: Per phase instead of HTTP_TIMEOUT
+  http.setTimeout(HTTP_READ_TIMEOUT);
+#if TLS_SESSION_RESUMPTION
+  backendTlsClient.setSessionCache(&wakeState.tlsSession);
+  backendTlsClient.setHandshakeTimeout(TLS_HANDSHAKE_TIMEOUT);
+#if TLS_VERIFY_SERVER
+  backendTlsClient.setCACert(BACKEND_ROOT_CA);
+#else
+  backendTlsClient.setInsecure();
+#endif
+  http.setReuse(false);
+  return http.begin(backendTlsClient, url);
+#elif TLS_VERIFY_SERVER
+  return http.begin(url, BACKEND_ROOT_CA);
+#else
+  return http.begin(url);
+#endif
+}
+
+// v2.2.0: Compact telemetry header, recorded by the backend as a heartbeat
+String buildTelemetryHeader() {
+  char telemetry[384];
+  int length = snprintf(telemetry, sizeof(telemetry), "rssi=%d;heap=%u;up=%llu;cyc=%lu;awake=%lu",
+                        wifiConnected ? WiFi.RSSI() : 0,
+                        (unsigned)ESP.getFreeHeap(),
+                        (unsigned long long)monotonicMillis(),
+                        (unsigned long)wakeState.cycleCount,
+                        (unsigned long)wakeState.lastAwakeMs);
+  
+  // v2.2.0: Battery voltage and power mode
+  if (wakeState.batteryMv != 0) {
+    length += snprintf(telemetry + length, sizeof(telemetry) - length, ";bat=%u;pm=%u",
+                       wakeState.batteryMv, (unsigned)wakeState.powerMode);
+  }
+  
+  // v2.2.0: Phase profile - last completed cycle (ph) and mean over the ring (pa)
+  if (wakeState.profileCount > 0) {
+    int last = (wakeState.profileHead + PROFILE_RING_SIZE - 1) % PROFILE_RING_SIZE;
+    uint32_t sums[NUM_PROFILE_PHASES] = {0};
+    for (int i = 0; i < wakeState.profileCount; i++) {
+      for (int p = 0; p < NUM_PROFILE_PHASES; p++) {
+        sums[p] += wakeState.profileRing[i].phaseMs[p];
+      }
+    }
+    
+    const char* keys[] = {";ph=", ";pa="};
+    for (int k = 0; k < 2 && length < (int)sizeof(telemetry); k++) {
+      length += snprintf(telemetry + length, sizeof(telemetry) - length, "%s", keys[k]);
+      for (int p = 0; p < NUM_PROFILE_PHASES && length < (int)sizeof(telemetry); p++) {
+        unsigned long value = (k == 0) ? wakeState.profileRing[last].phaseMs[p]
+                                       : sums[p] / wakeState.profileCount;
+        length += snprintf(telemetry + length, sizeof(telemetry) - length,
+                           p == 0 ? "%lu" : "/%lu", value);
+      }
+    }
+    
+    // v2.2.0: Energy - last cycle's phase charge (q), its total with the deep
+    // sleep after it (qc), mean total over the ring (qa), source (qs: 0 model, 1 shunt)
+    const CycleProfile& profile = wakeState.profileRing[last];
+    uint32_t chargeSum = 0;
+    for (int i = 0; i < wakeState.profileCount; i++) {
+      chargeSum += cycleCharge(wakeState.profileRing[i]);
+    }
+    for (int p = 0; p < NUM_PROFILE_PHASES && length < (int)sizeof(telemetry); p++) {
+      length += snprintf(telemetry + length, sizeof(telemetry) - length,
+                         p == 0 ? ";q=%u" : "/%u", profile.phaseCharge[p]);
+    }
+    if (length < (int)sizeof(telemetry)) {
+      snprintf(telemetry + length, sizeof(telemetry) - length, ";qc=%lu;qa=%lu;qs=%d",
+               (unsigned long)cycleCharge(profile), (unsigned long)(chargeSum / wakeState.profileCount),
+               profile.measured ? 1 : 0);
+    }
+  }
+  return String(telemetry);
+}
+
+// ===============================================================================
+// PHASE PROFILER - v2.2.0
+// ===============================================================================
+
+int64_t profileCycleStartUs = 0; // esp_timer_get_time() the current cycle began at (0 = reset)
+
+// Add the time since startUs (esp_timer_get_time(); 0 = since reset) to a phase
+void profileRecord(ProfilePhase phase, int64_t startUs) {
+  profileSpan(phase, startUs, esp_timer_get_time());
+}
+
+// v2.2.0: Time and charge of one span of a phase
+void profileSpan(ProfilePhase phase, int64_t startUs, int64_t endUs) {
+  CycleProfile& profile = wakeState.profileCurrent;
+  bool measured = false;
+  uint32_t ms = profile.phaseMs[phase] + (uint32_t)((endUs - startUs) / 1000);
+  uint32_t charge = profile.phaseCharge[phase] + energyCharge(ENERGY_MODEL_MA[phase], startUs, endUs, measured);
+  profile.phaseMs[phase] = (ms > UINT16_MAX) ? UINT16_MAX : ms;
+  profile.phaseCharge[phase] = (charge > UINT16_MAX) ? UINT16_MAX : charge;
+  profile.measured |= measured;
+}
+
+// Split a request into DNS, TLS and the rest using the TLS client's own timings
+// (the lookup and handshake come first)
+void profileRecordRequest(int64_t startUs) {
+  int64_t networkUs = 0;
+#if TLS_SESSION_RESUMPTION
+  int64_t dnsUs = (int64_t)backendTlsClient.lastDnsMs() * 1000;
+  int64_t tlsUs = (int64_t)backendTlsClient.lastHandshakeMs() * 1000;
+  profileSpan(PHASE_DNS, startUs, startUs + dnsUs);
+  profileSpan(PHASE_TLS, startUs + dnsUs, startUs + dnsUs + tlsUs);
+  networkUs = dnsUs + tlsUs;
+#endif
+  profileRecord(PHASE_HTTP, startUs + networkUs);
+}
+
+// Move the measured cycle into the RTC ring and start a new one
+void profileCommitCycle() {
+  int64_t nowUs = esp_timer_get_time();
+  bool measured = false;
+  wakeState.profileCurrent.cycle = wakeState.cycleCount;
+  wakeState.profileCurrent.awakeCharge = energyAwakeCharge(profileCycleStartUs, nowUs, measured);
+  wakeState.profileCurrent.measured |= measured;
+  profileCycleStartUs = nowUs;
+  wakeState.profileRing[wakeState.profileHead] = wakeState.profileCurrent;
+  wakeState.profileHead = (wakeState.profileHead + 1) % PROFILE_RING_SIZE;
+  if (wakeState.profileCount < PROFILE_RING_SIZE) {
+    wakeState.profileCount++;
+  }
+  
+  DEBUG_PRINTF("Cycle %lu phases (ms): boot %u wifi %u dns %u tls %u http %u parse %u render %u panel %u hb %u sleep %u\n",
+               (unsigned long)wakeState.profileCurrent.cycle,
+               wakeState.profileCurrent.phaseMs[PHASE_BOOT], wakeState.profileCurrent.phaseMs[PHASE_WIFI],
+               wakeState.profileCurrent.phaseMs[PHASE_DNS], wakeState.profileCurrent.phaseMs[PHASE_TLS],
+               wakeState.profileCurrent.phaseMs[PHASE_HTTP], wakeState.profileCurrent.phaseMs[PHASE_PARSE],
+               wakeState.profileCurrent.phaseMs[PHASE_RENDER], wakeState.profileCurrent.phaseMs[PHASE_PANEL],
+               wakeState.profileCurrent.phaseMs[PHASE_HEARTBEAT], wakeState.profileCurrent.phaseMs[PHASE_SLEEP]);
+  DEBUG_PRINTF("Cycle %lu charge (%s, mA*s): awake %u.%u sleep %u.%u\n",
+               (unsigned long)wakeState.profileCurrent.cycle,
+               wakeState.profileCurrent.measured ? "shunt" : "model",
+               wakeState.profileCurrent.awakeCharge / 10, wakeState.profileCurrent.awakeCharge % 10,
+               wakeState.profileCurrent.sleepCharge / 10, wakeState.profileCurrent.sleepCharge % 10);
+  
+  memset(&wakeState.profileCurrent, 0, sizeof(wakeState.profileCurrent));
+  wakeState.profileCycleDone = false;
+}
+
+// ===============================================================================
+// ENERGY PROFILER - v2.2.0
+// ===============================================================================
+
+// Charge is kept in tenths of mA·s. Without a shunt (ENERGY_SHUNT 0) it is
+// modelled from the time in each phase; with one, a periodic timer samples
+// the amplifier output and the ring of running sums gives the charge of any
+// span still in it - the part of a span it doesn't cover (before the timer
+// started, or already overwritten) is modelled.
+#if ENERGY_SHUNT
+esp_timer_handle_t energyTimer = NULL;
+int64_t energyStartUs = 0;                     // esp_timer_get_time() of sample 0
+volatile uint32_t energySampleCount = 0;
+uint32_t energyRunningUa[ENERGY_SAMPLE_RING];  // Sum of the µA readings up to each sample (wraps)
+uint64_t energyTotalUa = 0;                    // Sum of all readings since the timer started
+uint64_t energyCycleBaseUa = 0;                // energyTotalUa when the current cycle began
+portMUX_TYPE energyLock = portMUX_INITIALIZER_UNLOCKED; // 64-bit total read from the loop task
+
+void energySample(void* arg) {
+  uint32_t millivolts = analogReadMilliVolts(ENERGY_SHUNT_ADC_PIN);
+  uint32_t microamps = (uint32_t)((uint64_t)millivolts * 1000000ULL /
+                                  ((uint64_t)ENERGY_SHUNT_GAIN * ENERGY_SHUNT_MILLIOHM));
+  uint32_t count = energySampleCount;
+  uint32_t previous = count ? energyRunningUa[(count - 1) % ENERGY_SAMPLE_RING] : 0;
+  energyRunningUa[count % ENERGY_SAMPLE_RING] = previous + microamps;
+  portENTER_CRITICAL(&energyLock);
+  energyTotalUa += microamps;
+  portEXIT_CRITICAL(&energyLock);
+  energySampleCount = count + 1;
+}
+
+// Running sum up to sample index (-1 = before the first sample)
+uint32_t energyRunningAt(int64_t index) {
+  return index < 0 ? 0 : energyRunningUa[index % ENERGY_SAMPLE_RING];
+}
+#endif
+
+// 0.1 mA·s = 1e8 µA·µs
+uint32_t modelCharge(uint16_t milliamps, uint64_t durationUs) {
+  return (uint32_t)((durationUs * milliamps * 1000ULL + 50000000ULL) / 100000000ULL);
+}
+
+void energyBegin() {
+#if ENERGY_SHUNT
+  esp_timer_create_args_t args = {};
+  args.callback = energySample;
+  args.name = "energy";
+  if (esp_timer_create(&args, &energyTimer) != ESP_OK) {
+    energyTimer = NULL;
+    return;
+  }
+  energyStartUs = esp_timer_get_time();
+  esp_timer_start_periodic(energyTimer, ENERGY_SAMPLE_INTERVAL_US);
+#endif
+}
+
+// Charge between two esp_timer_get_time() stamps at modelMa where no samples
+// cover the span; sets measured when any part of it was sampled
+uint32_t energyCharge(uint16_t modelMa, int64_t startUs, int64_t endUs, bool& measured) {
+  if (endUs <= startUs) return 0;
+  uint64_t modelUs = endUs - startUs;
+  uint64_t measuredUaUs = 0;
+#if ENERGY_SHUNT
+  if (energyTimer) {
+    // Whole samples inside the span that the ring still holds (one slot of
+    // margin for a sample landing while this reads)
+    int64_t count = energySampleCount;
+    int64_t first = max((int64_t)0, (startUs - energyStartUs + ENERGY_SAMPLE_INTERVAL_US - 1) / ENERGY_SAMPLE_INTERVAL_US);
+    int64_t last = min(count, (endUs - energyStartUs) / ENERGY_SAMPLE_INTERVAL_US); // Exclusive
+    first = max(first, count - ENERGY_SAMPLE_RING + 2);
+    if (last > first) {
+      uint32_t sumUa = energyRunningAt(last - 1) - energyRunningAt(first - 1);
+      measuredUaUs = (uint64_t)sumUa * ENERGY_SAMPLE_INTERVAL_US;
+      modelUs -= min(modelUs, (uint64_t)(last - first) * ENERGY_SAMPLE_INTERVAL_US);
+      measured = true;
+    }
+  }
+#endif
+  return (uint32_t)((measuredUaUs + 50000000ULL) / 100000000ULL) + modelCharge(modelMa, modelUs);
+}
+
+// Whole awake time of a cycle - phases overlap (display task, pipelined
+// heartbeat), so this is the figure to compare builds by, not their sum
+uint16_t energyAwakeCharge(int64_t startUs, int64_t endUs, bool& measured) {
+  uint32_t charge = 0;
+#if ENERGY_SHUNT
+  if (energyTimer) {
+    // The cycle can outlast the ring - use the running total instead
+    if (startUs < energyStartUs) {
+      charge = modelCharge(ENERGY_MODEL_MA[PHASE_BOOT], energyStartUs - startUs); // ROM boot
+    }
+    portENTER_CRITICAL(&energyLock);
+    uint64_t sumUa = energyTotalUa - energyCycleBaseUa;
+    energyCycleBaseUa = energyTotalUa;
+    portEXIT_CRITICAL(&energyLock);
+    charge += (uint32_t)((sumUa * ENERGY_SAMPLE_INTERVAL_US + 50000000ULL) / 100000000ULL);
+    measured = true;
+    return (charge > UINT16_MAX) ? UINT16_MAX : charge;
+  }
+#endif
+  // Modelled: the phases plus idle current for the awake time outside them
+  uint32_t phaseMs = 0;
+  for (int p = 0; p < NUM_PROFILE_PHASES; p++) {
+    charge += wakeState.profileCurrent.phaseCharge[p];
+    phaseMs += wakeState.profileCurrent.phaseMs[p];
+  }
+  int64_t idleUs = (endUs - startUs) - (int64_t)phaseMs * 1000;
+  if (idleUs > 0) {
+    charge += modelCharge(ENERGY_MODEL_IDLE_MA, idleUs);
+  }
+  return (charge > UINT16_MAX) ? UINT16_MAX : charge;
+}
+
+// Deep sleep between cycles (never sampled - the timer stops with the CPU)
+uint16_t energySleepCharge(unsigned long sleepMs) {
+  uint64_t charge = ((uint64_t)sleepMs * ENERGY_DEEP_SLEEP_UA + 50000ULL) / 100000ULL; // µA·ms -> 0.1 mA·s
+  return (charge > UINT16_MAX) ? UINT16_MAX : charge;
+}
+
+uint32_t cycleCharge(const CycleProfile& profile) {
+  return (uint32_t)profile.awakeCharge + profile.sleepCharge;
+}
+
+// Upload the whole ring once per fill - the cycle after it wraps
+bool energyTraceDue() {
+  return ENERGY_TRACE_UPLOAD && wakeState.profileCount == PROFILE_RING_SIZE &&
+         wakeState.profileHead == 0;
+}
+
+// JSON array of the RTC ring, oldest first: cycle, source, phase ms and charge,
+// awake and sleep charge (tenths of mA·s, as in telemetry)
+String buildEnergyTrace() {
+  String trace = "[";
+  for (int i = 0; i < wakeState.profileCount; i++) {
+    int slot = (wakeState.profileHead + PROFILE_RING_SIZE - wakeState.profileCount + i) % PROFILE_RING_SIZE;
+    const CycleProfile& profile = wakeState.profileRing[slot];
+    char entry[48];
+    snprintf(entry, sizeof(entry), "%s{\"cyc\":%lu,\"src\":%d,\"ms\":[", i ? "," : "",
+             (unsigned long)profile.cycle, profile.measured ? 1 : 0);
+    trace += entry;
+    for (int p = 0; p < NUM_PROFILE_PHASES; p++) {
+      if (p) trace += ',';
+      trace += (unsigned)profile.phaseMs[p];
+    }
+    trace += "],\"q\":[";
+    for (int p = 0; p < NUM_PROFILE_PHASES; p++) {
+      if (p) trace += ',';
+      trace += (unsigned)profile.phaseCharge[p];
+    }
+    // qw/qz: awake and sleep charge (qa/qs are taken by the telemetry header)
+    snprintf(entry, sizeof(entry), "],\"qw\":%u,\"qz\":%u}", profile.awakeCharge, profile.sleepCharge);
+    trace += entry;
+  }
+  trace += "]";
+  return trace;
+}
+
+// ===============================================================================
+// BATTERY MONITOR - v2.2.0
+// ===============================================================================
+
+// Averaged reading through the BAT+ divider, taken before WiFi starts so the
+// radio's current draw doesn't pull the reading down
+void sampleBattery() {
+#if BATTERY_MONITOR
+  uint32_t sum = 0;
+  for (int i = 0; i < BATTERY_SAMPLES; i++) {
+    sum += analogReadMilliVolts(BATTERY_ADC_PIN);
+  }
+  uint32_t millivolts = (uint32_t)(sum * BATTERY_DIVIDER_RATIO / BATTERY_SAMPLES);
+  batterySampleMv = (millivolts >= BATTERY_PRESENT_MV) ? millivolts : 0; // USB only / no divider
+#endif
+}
+
+// Fold this wake's sample into the smoothed voltage and move between modes
+// with hysteresis, so a reading near a threshold doesn't flip modes every cycle
+PowerMode updatePowerMode() {
+  if (batterySampleMv == 0) {
+    wakeState.batteryMv = 0;
+    wakeState.powerMode = POWER_NORMAL;
+  } else {
+    wakeState.batteryMv = (wakeState.batteryMv == 0) ? batterySampleMv
+                        : (wakeState.batteryMv * 3 + batterySampleMv) / 4;
+    
+    uint16_t mv = wakeState.batteryMv;
+    PowerMode mode = wakeState.powerMode;
+    if (mv < BATTERY_CRITICAL_MV) {
+      mode = POWER_CRITICAL;
+    } else if (mv < BATTERY_CONSERVE_MV) {
+      if (mode != POWER_CRITICAL || mv >= BATTERY_CRITICAL_MV + BATTERY_HYSTERESIS_MV) {
+        mode = POWER_CONSERVE;
+      }
+    } else if (mode == POWER_NORMAL || mv >= BATTERY_CONSERVE_MV + BATTERY_HYSTERESIS_MV) {
+      mode = POWER_NORMAL;
+    } else if (mode == POWER_CRITICAL) {
+      mode = POWER_CONSERVE;
+    }
+    
+    if (mode != wakeState.powerMode) {
+      DEBUG_PRINTF("Power mode %u -> %u (%umV)\n", (unsigned)wakeState.powerMode, (unsigned)mode, mv);
+    }
+    wakeState.powerMode = mode;
+  }
+  
+  if (wakeState.powerMode != POWER_CRITICAL) {
+    wakeState.lowBatteryShown = false;
+  }
+  return wakeState.powerMode;
+}
+
+// Rough state of charge - linear between BATTERY_EMPTY_MV and BATTERY_FULL_MV
+int batteryPercent() {
+  int percent = ((int)wakeState.batteryMv - BATTERY_EMPTY_MV) * 100 / (BATTERY_FULL_MV - BATTERY_EMPTY_MV);
+  return constrain(percent, 0, 100);
+}
+
+// Conserve mode reports telemetry only every Nth cycle
+bool telemetryDue() {
+  return wakeState.powerMode != POWER_CONSERVE ||
+         (wakeState.cycleCount % CONSERVE_HEARTBEAT_EVERY) == 0;
+}
+
 // ===============================================================================
 // SETTINGS PERSISTENCE
 // ===============================================================================
 
+void openPreferences() {
+  if (!preferencesOpen) {
+    preferences.begin("weather-display", false);
+    preferencesOpen = true;
+  }
+}
+
 void loadSettings() {
   DEBUG_PRINTLN("Loading settings from flash...");
   
@@ -952,11 +2236,8 @@ void loadSettings() {
   
   // Set default region display name if not registered yet
   if (!isRegistered) {
-    if (currentRegionId == "chamonix") {
-      regionDisplayName = "Chamonix Valley";
-    } else {
-      regionDisplayName = "Solent Marine";
-    }
+    const RegionInfo* region = findRegion(currentRegionId.c_str());
+    regionDisplayName = region ? region->displayName : currentRegionId;
   }
   
   DEBUG_PRINTF("Loaded - Registered: %s, Region: %s\n", 
@@ -967,27 +2248,122 @@ void loadSettings() {
 void saveSettings() {
   DEBUG_PRINTLN("Saving settings to flash...");
   
+  openPreferences(); // v2.2.0: Not opened on warm wake
   preferences.putBool("registered", isRegistered);
   preferences.putString("regionId", currentRegionId);
   
   DEBUG_PRINTLN("Settings saved");
 }
 
+// v2.2.0: RTC wake state - cleared on cold boot, saved before every deep sleep
+void resetWakeState() {
+  memset(&wakeState, 0, sizeof(wakeState));
+  wakeState.magic = WAKE_STATE_MAGIC;
+  wakeState.wifiNetworkIndex = -1;
+}
+
+void saveWakeState() {
+  wakeState.magic = WAKE_STATE_MAGIC;
+  wakeState.isRegistered = isRegistered;
+  wakeState.dataValid = dataValid;
+  strlcpy(wakeState.regionId, currentRegionId.c_str(), sizeof(wakeState.regionId));
+  
+  memcpy(wakeState.stations, stations, sizeof(stations));
+  memcpy(wakeState.history, stationHistory, sizeof(stationHistory));
+  
+  DEBUG_PRINTF("Wake state saved (cycle %lu, region %s)\n",
+               (unsigned long)wakeState.cycleCount, wakeState.regionId);
+}
+
+void restoreWakeState() {
+  isRegistered = wakeState.isRegistered;
+  dataValid = wakeState.dataValid;
+  currentRegionId = wakeState.regionId;
+  memcpy(stations, wakeState.stations, sizeof(stations));
+  memcpy(stationHistory, wakeState.history, sizeof(stationHistory));
+  
+  DEBUG_PRINTF("Wake state restored - Registered: %s, Region: %s, Data valid: %s\n",
+               isRegistered ? "true" : "false",
+               currentRegionId.c_str(),
+               dataValid ? "true" : "false");
+}
+
 // ===============================================================================
 // UTILITY FUNCTIONS
 // ===============================================================================
 
-// Wind speed unit conversion for regional display preferences
-// Backend v2.0.0 always returns m/s, convert to user-friendly regional units
-float convertWindSpeed(float speedMs, String targetUnit) {
-  if (targetUnit == "kts") {
-    return speedMs * 1.94384; // m/s to knots (marine stations)
-  } else if (targetUnit == "kph") {
-    return speedMs * 3.6; // m/s to km/h (alpine stations)
-  } else if (targetUnit == "mph") {
-    return speedMs * 2.237; // m/s to mph (optional)
-  }
-  return speedMs; // Default: return m/s unchanged
+// v2.2.0: Milliseconds since cold boot, including time spent in deep sleep
+uint64_t monotonicMillis() {
+  return wakeState.elapsedMs + millis();
+}
+
+// v2.2.0: Per-region hashes of the rendered content, formatted exactly as drawn
+// (converted units, one decimal). Mem%/Bat% are left out - they drift every cycle
+// and are refreshed by the DISPLAY_MAX_STALENESS forced refresh instead. Station
+// hashes are seeded with the layout: a layout change moves every field.
+void computeRegionHashes(uint32_t* regionHashes) {
+  const StationLayout& layout = stationLayoutFor(stations);
+  uint32_t layoutSeed = fnv1aHash(layout.name, strlen(layout.name));
+  for (int i = 0; i < STATION_SLOTS; i++) {
+    for (int field = 0; field < FIELDS_PER_STATION; field++) {
+      char text[FIELD_TEXT_SIZE] = "";
+      if (stations[i].stationName[0] != '\0') {
+        stationFieldText(stations[i], field, text, sizeof(text));
+      }
+      regionHashes[i * FIELDS_PER_STATION + field] = fnv1aUpdate(layoutSeed, text, strlen(text));
+    }
+    
+    // Trend boxes: the samples in drawing order (none when the layout has no box)
+    uint32_t trend = layoutSeed;
+    if (TREND_HISTORY && stationTrendRect(layout, i).h > 0 && stationHistory[i].stationHash != 0) {
+      for (int age = 0; age < HISTORY_SAMPLES; age++) {
+        WindSample sample = windHistorySample(stationHistory[i], age);
+        trend = fnv1aUpdate(trend, (const char*)&sample, sizeof(sample));
+      }
+    }
+    regionHashes[REGION_TREND_FIRST + i] = trend;
+  }
+  
+  char updated[FIELD_TEXT_SIZE];
+  footerUpdatedText(updated, sizeof(updated));
+  regionHashes[REGION_FOOTER_UPDATED] = fnv1aHash(updated, strlen(updated));
+  
+  int bars = wifiConnected ? wifiSignalBars() : -1;
+  regionHashes[REGION_FOOTER_WIFI] = fnv1aHash((const char*)&bars, sizeof(bars));
+  
+  char staleMarker[FIELD_TEXT_SIZE];
+  staleMarkerText(staleMarker, sizeof(staleMarker));
+  regionHashes[REGION_FOOTER_STALE] = fnv1aHash(staleMarker, strlen(staleMarker));
+}
+
+// v2.2.0: Station fields whose drawn text differs from the panel's, one bit per
+// station region - what incremental redraw and partial refresh both cover
+uint32_t changedStationFields(const uint32_t* regionHashes) {
+  uint32_t changed = 0;
+  for (int r = 0; r < NUM_STATION_REGIONS; r++) {
+    if (regionHashes[r] != wakeState.regionHashes[r]) changed |= 1UL << r;
+  }
+  return changed;
+}
+
+// v2.2.0: Trend boxes whose samples differ from the panel's, one bit per station slot
+uint32_t changedStationTrends(const uint32_t* regionHashes) {
+  uint32_t changed = 0;
+  for (int i = 0; i < STATION_SLOTS; i++) {
+    if (regionHashes[REGION_TREND_FIRST + i] != wakeState.regionHashes[REGION_TREND_FIRST + i]) changed |= 1UL << i;
+  }
+  return changed;
+}
+
+// v2.2.0: Whole-frame fingerprint - region hashes plus which screen is showing
+uint32_t computeDisplayFingerprint(const uint32_t* regionHashes, bool showData) {
+  uint32_t hash = fnv1aHash((const char*)regionHashes, NUM_DISPLAY_REGIONS * sizeof(uint32_t));
+  
+  if (!showData) {
+    String errorState = String(wifiConnected ? 1 : 0) + "|" + lastError;
+    hash = fnv1aUpdate(hash, errorState.c_str(), errorState.length());
+  }
+  return fnv1aUpdate(hash, (const char*)&showData, sizeof(showData));
 }
 
 void blinkLED(int times, int delayMs) {
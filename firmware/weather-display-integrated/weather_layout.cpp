@@ -0,0 +1,463 @@
+/**
+ * Weather Layout v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * See weather_layout.h.
+ */
+
+#include "weather_layout.h"
+#include "config.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Static layer - field labels are drawn once with the station names and rules,
+// values are drawn after them at the label's measured width
+static const char* const FIELD_LABELS[FIELDS_PER_STATION] = {
+  "", "Wind Dir: ", "Wind Speed: ", "Wind Gust: ", "Air Temp: "
+};
+static int16_t labelWidths[FIELDS_PER_STATION]; // Label widths in the layout's field fonts, measured with the layer
+
+static uint8_t* staticLayer = NULL;   // Reserved heap block, allocated on first use
+static uint32_t staticLayerKey = 0;   // Station set the cached layer was drawn for (0 = none)
+
+static void drawWiFiSignalBars(TFT_eSprite& sprite, FrameBuffer& frame, int bars, int x, int y);
+static void drawTrendAxis(FrameBuffer& frame, const StationLayout& layout, int slot);
+static void drawTrend(TFT_eSprite& sprite, FrameBuffer& frame, const StationLayout& layout,
+                      const StationHistory& history, int slot);
+static void drawFieldValue(TFT_eSprite& sprite, FrameBuffer& frame, const StationLayout& layout,
+                           const StationData& station, int slot, int line);
+
+const int FOOTER_BAND_Y = 441; // Below the footer rule - everything the footer draws
+const int FOOTER_TEXT_Y = 460;       // Bitmap font top of the footer line
+const int FOOTER_UPDATED_X = 10;
+const int FOOTER_WIFI_X = 185;       // Signal bars, bottom-left corner at FOOTER_WIFI_Y
+const int FOOTER_WIFI_Y = 468;
+const int FOOTER_STALE_X = 480;
+
+// ===============================================================================
+// STATION LAYOUTS
+// ===============================================================================
+
+const StationLayout& stationLayoutFor(const StationData* stations) {
+  int used = 0;
+  for (int i = 0; i < STATION_SLOTS; i++) {
+    if (stations[i].stationName[0] != '\0') used = i + 1;
+  }
+  for (int i = 0; i < NUM_STATION_LAYOUTS; i++) {
+    if (layoutSlots(STATION_LAYOUTS[i]) >= used) return STATION_LAYOUTS[i];
+  }
+  return STATION_LAYOUTS[NUM_STATION_LAYOUTS - 1];
+}
+
+// Top-left of a slot (its station name)
+static int16_t slotX(const StationLayout& layout, int slot) {
+  return layout.x + (slot % layout.columns) * layout.columnPitch;
+}
+
+static int16_t slotY(const StationLayout& layout, int slot) {
+  return layout.y + (slot / layout.columns) * layout.rowPitch;
+}
+
+static int16_t fieldLineY(const StationLayout& layout, int slot, int line) {
+  return slotY(layout, slot) + layout.fieldOffset + line * layout.fieldSpacing;
+}
+
+// Line of a field within its slot, -1 when the layout doesn't show it
+static int fieldLine(const StationLayout& layout, int field) {
+  for (int line = 0; line < layout.fieldCount; line++) {
+    if (layout.fields[line].field == field) return line;
+  }
+  return -1;
+}
+
+// Identifies the station set (and so the layout) the static layer was drawn for
+static uint32_t stationSetKey(const StationData* stations) {
+  const StationLayout& layout = stationLayoutFor(stations);
+  uint32_t key = fnv1aHash(layout.name, strlen(layout.name));
+  for (int i = 0; i < layoutSlots(layout); i++) {
+    key = fnv1aUpdate(key, stations[i].stationName, strlen(stations[i].stationName) + 1);
+  }
+  return key;
+}
+
+// Copy the cached static layer into the frame buffer, rendering it first when
+// the station set changed. Returns false when the cache is unavailable
+// (disabled, no frame buffer access, or the 48 KB block could not be reserved).
+static bool restoreStaticLayer(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations) {
+#if STATIC_LAYER_CACHE
+  uint8_t* frameBytes = (uint8_t*)sprite.getPointer();
+  if (!frameBytes || !frame.direct()) return false;
+  size_t layerBytes = (size_t)(sprite.width() + 7) / 8 * sprite.height(); // 1 bpp
+
+  if (!staticLayer) {
+    staticLayer = (uint8_t*)malloc(layerBytes);
+    if (!staticLayer) return false;
+  }
+
+  uint32_t key = stationSetKey(stations);
+  if (key != staticLayerKey) {
+    frame.fillScreen(TFT_WHITE);
+    drawStaticLayer(frame, stations);
+    memcpy(staticLayer, frameBytes, layerBytes);
+    staticLayerKey = key;
+  } else {
+    memcpy(frameBytes, staticLayer, layerBytes);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+void drawWeatherData(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                     const StationHistory* history) {
+  // Names, labels and rules come from the cache when the station set is
+  // unchanged - only the values are rasterized each refresh
+  if (!restoreStaticLayer(sprite, frame, stations)) {
+    frame.fillScreen(TFT_WHITE);
+    drawStaticLayer(frame, stations);
+  }
+  drawValueLayer(sprite, frame, stations, history);
+}
+
+// Copy one rectangle of the cached static layer back into the frame (whole bytes,
+// so a few pixels either side come along - all static content)
+static void restoreStaticRect(TFT_eSprite& sprite, LayoutRect rect) {
+  uint8_t* frameBytes = (uint8_t*)sprite.getPointer();
+  size_t stride = (size_t)(sprite.width() + 7) / 8;
+  int x0 = rect.x < 0 ? 0 : rect.x / 8;
+  int x1 = (rect.x + rect.w + 7) / 8;
+  if (x1 > (int)stride) x1 = (int)stride;
+  int y1 = rect.y + rect.h;
+  if (y1 > sprite.height()) y1 = sprite.height();
+
+  for (int row = rect.y < 0 ? 0 : rect.y; row < y1 && x1 > x0; row++) {
+    memcpy(frameBytes + row * stride + x0, staticLayer + row * stride + x0, x1 - x0);
+  }
+}
+
+bool drawChangedFields(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                       const StationHistory* history, uint32_t changedFields, uint32_t changedTrends) {
+#if STATIC_LAYER_CACHE
+  if (!staticLayer || !sprite.getPointer() || !frame.direct() ||
+      stationSetKey(stations) != staticLayerKey) {
+    return false;
+  }
+
+  const StationLayout& layout = stationLayoutFor(stations);
+  for (int i = 0; i < layoutSlots(layout); i++) {
+    if (changedFields & (1UL << (i * FIELDS_PER_STATION + FIELD_STATION_NAME))) return false;
+  }
+
+  for (int i = 0; i < layoutSlots(layout); i++) {
+    if (stations[i].stationName[0] == '\0') continue;
+
+    for (int line = 0; line < layout.fieldCount; line++) {
+      int field = layout.fields[line].field;
+      if (!(changedFields & (1UL << (i * FIELDS_PER_STATION + field)))) continue;
+      restoreStaticRect(sprite, stationFieldRect(layout, i, field));
+      drawFieldValue(sprite, frame, layout, stations[i], i, line);
+    }
+
+    if (history && (changedTrends & (1UL << i))) {
+      restoreStaticRect(sprite, stationTrendRect(layout, i));
+      drawTrend(sprite, frame, layout, history[i], i);
+    }
+  }
+
+  LayoutRect footer = {0, (int16_t)FOOTER_BAND_Y, (int16_t)sprite.width(), (int16_t)(sprite.height() - FOOTER_BAND_Y)};
+  restoreStaticRect(sprite, footer);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void drawStaticLayer(FrameBuffer& frame, const StationData* stations) {
+  // v2.1.2 Layout: Enhanced typography with GFX Free Fonts
+  // v2.1.4: Data fields with FreeSans 12pt for readability - values continue at
+  // the label's cursor advance, as they did when drawn in one string
+  const StationLayout& layout = stationLayoutFor(stations);
+  for (int line = 0; line < layout.fieldCount; line++) {
+    int field = layout.fields[line].field;
+    labelWidths[field] = FrameBuffer::textAdvance(layout.fields[line].font, FIELD_LABELS[field]);
+  }
+
+  for (int i = 0; i < layoutSlots(layout); i++) {
+    if (stations[i].stationName[0] == '\0') continue;
+
+    int x = slotX(layout, i);
+    int y = slotY(layout, i);
+
+    // v2.1.4: Station name with FreeSansBold 18pt for prominence
+    frame.drawString(layout.nameFont, stations[i].stationName, x, y, TFT_BLACK);
+
+    // v2.1.4: Add horizontal line under station name for visual separation
+    frame.drawFastHLine(x, y + 27, layout.columnWidth - 9, TFT_BLACK);
+
+    // v2.1.5: Capitalized labels, one per field line
+    for (int line = 0; line < layout.fieldCount; line++) {
+      frame.drawString(layout.fields[line].font, FIELD_LABELS[layout.fields[line].field], x,
+                       fieldLineY(layout, i, line), TFT_BLACK);
+    }
+
+    drawTrendAxis(frame, layout, i);
+
+    // Draw vertical separator line (except after last column)
+    if (i % layout.columns < layout.columns - 1) {
+      frame.drawFastVLine(x + layout.columnWidth, y - 5, layout.separatorHeight, TFT_BLACK);
+    }
+  }
+
+  // v2.1.2: Horizontal line much closer to footer
+  frame.drawFastHLine(10, 440, 781, TFT_BLACK);
+}
+
+// GFX fonts have no kerning, so label + value lands on the same pixels as the
+// combined string did
+void drawValueLayer(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                    const StationHistory* history) {
+  const StationLayout& layout = stationLayoutFor(stations);
+  for (int i = 0; i < layoutSlots(layout); i++) {
+    if (stations[i].stationName[0] == '\0') continue;
+
+    for (int line = 0; line < layout.fieldCount; line++) {
+      drawFieldValue(sprite, frame, layout, stations[i], i, line);
+    }
+    if (history) {
+      drawTrend(sprite, frame, layout, history[i], i);
+    }
+  }
+}
+
+static void drawFieldValue(TFT_eSprite& sprite, FrameBuffer& frame, const StationLayout& layout,
+                           const StationData& station, int slot, int line) {
+  char value[FIELD_TEXT_SIZE];
+  int field = layout.fields[line].field;
+  const GFXfont* font = layout.fields[line].font;
+  int y = fieldLineY(layout, slot, line);
+  int valueX = slotX(layout, slot) + labelWidths[field];
+  stationFieldValue(station, field, value, sizeof(value));
+  frame.drawString(font, value, valueX, y, TFT_BLACK);
+
+  // v2.1.6: Enhanced degree symbol (bigger, thicker outline, lower) after the
+  // direction and temperature numbers
+  if (field == FIELD_WIND_DIR || field == FIELD_AIR_TEMP) {
+    int valueWidth = FrameBuffer::textWidth(font, value);
+    int centerX = valueX + valueWidth + 3;
+    int centerY = y - 4;
+    sprite.drawCircle(centerX, centerY, 3, TFT_BLACK);  // Main circle
+    sprite.drawCircle(centerX, centerY, 2, TFT_BLACK);  // Inner circle for thickness
+    if (field == FIELD_AIR_TEMP) {
+      frame.drawString(font, "C", valueX + valueWidth + 8, y, TFT_BLACK); // 'C' after degree symbol
+    }
+  }
+}
+
+// Field rectangles stop short of the next line, so restoring one never clips
+// the degree symbol of the field below
+LayoutRect stationFieldRect(const StationLayout& layout, int slot, int field) {
+  int16_t x = slotX(layout, slot);
+  int16_t width = layout.columnWidth - 10;
+  if (field == FIELD_STATION_NAME) {
+    return {x, (int16_t)(slotY(layout, slot) - 5), width, 36}; // Name + rule at y + 27
+  }
+  int line = fieldLine(layout, field);
+  if (line < 0) {
+    return {0, 0, 0, 0};
+  }
+  int16_t y = fieldLineY(layout, slot, line);
+  return {x, (int16_t)(y - 8), width, (int16_t)(layout.fieldSpacing - 4)};
+}
+
+// ===============================================================================
+// WIND TRENDS
+// ===============================================================================
+
+// Sparkline of the last HISTORY_SAMPLES buckets, newest at the right: average
+// wind as a line, gusts as dots above it, scaled to the window's strongest gust.
+// Tall boxes add a row of direction ticks (pointing downwind) under the axis.
+const int TREND_MIN_SCALE = 20;       // Quantized steps at the top of the box, at least 10 m/s
+const int TREND_DIRECTION_ROW = 16;   // Height of the direction tick row
+const int TREND_DIRECTION_EVERY = 4;  // One tick per 4 buckets (12 minutes)
+const int TREND_TICK_RADIUS = 6;
+
+LayoutRect stationTrendRect(const StationLayout& layout, int slot) {
+  if (layout.trendHeight == 0) {
+    return {0, 0, 0, 0};
+  }
+  return {slotX(layout, slot), (int16_t)(slotY(layout, slot) + layout.trendOffset),
+          (int16_t)(layout.columnWidth - 10), layout.trendHeight};
+}
+
+// Baseline of the sparkline (static layer)
+static int16_t trendAxisY(const StationLayout& layout, LayoutRect box) {
+  return box.y + box.h - 1 - (layout.trendDirections ? TREND_DIRECTION_ROW : 0);
+}
+
+static void drawTrendAxis(FrameBuffer& frame, const StationLayout& layout, int slot) {
+  LayoutRect box = stationTrendRect(layout, slot);
+  if (box.h == 0) return;
+  frame.drawFastHLine(box.x, trendAxisY(layout, box), box.w, TFT_BLACK);
+}
+
+static void drawTrend(TFT_eSprite& sprite, FrameBuffer& frame, const StationLayout& layout,
+                      const StationHistory& history, int slot) {
+  LayoutRect box = stationTrendRect(layout, slot);
+  if (box.h == 0 || history.stationHash == 0) return;
+
+  int scale = TREND_MIN_SCALE;
+  for (int age = 0; age < HISTORY_SAMPLES; age++) {
+    WindSample sample = windHistorySample(history, age);
+    if (sample.avg == HISTORY_NONE) continue;
+    if (sample.avg > scale) scale = sample.avg;
+    if (sample.gust != HISTORY_NONE && sample.gust > scale) scale = sample.gust;
+  }
+
+  // Everything stays inside the box, so restoring it clears the old trend
+  int bottom = trendAxisY(layout, box) - 2; // Calm sits just above the axis
+  int plotHeight = bottom - box.y - 2;
+  int inset = layout.trendDirections ? TREND_TICK_RADIUS + 1 : 1;
+  int plotWidth = box.w - 2 * inset;
+  int tickY = box.y + box.h - TREND_DIRECTION_ROW / 2;
+  int previousX = -1;
+  int previousY = 0;
+
+  for (int age = HISTORY_SAMPLES - 1; age >= 0; age--) {
+    WindSample sample = windHistorySample(history, age);
+    int x = box.x + inset + (plotWidth - 1) - age * (plotWidth - 1) / (HISTORY_SAMPLES - 1);
+    if (sample.avg == HISTORY_NONE) {
+      previousX = -1; // Gap where the unit slept through buckets or had no data
+      continue;
+    }
+
+    int y = bottom - sample.avg * plotHeight / scale;
+    if (previousX >= 0) {
+      sprite.drawLine(previousX, previousY, x, y, TFT_BLACK);
+      sprite.drawLine(previousX, previousY - 1, x, y - 1, TFT_BLACK); // Two pixels thick
+    } else {
+      frame.fillRect(x, y - 1, 1, 2, TFT_BLACK);
+    }
+    previousX = x;
+    previousY = y;
+
+    if (sample.gust != HISTORY_NONE) {
+      frame.fillRect(x - 1, bottom - sample.gust * plotHeight / scale - 1, 2, 2, TFT_BLACK);
+    }
+
+    if (layout.trendDirections && age % TREND_DIRECTION_EVERY == 0) {
+      float angle = sample.direction * (float)(2.0 * M_PI / 256.0);
+      int dx = (int)lroundf(sinf(angle) * TREND_TICK_RADIUS);
+      int dy = (int)lroundf(-cosf(angle) * TREND_TICK_RADIUS);
+      // Wind comes from the direction - the tick runs from there to a dot downwind
+      sprite.drawLine(x + dx, tickY + dy, x - dx, tickY - dy, TFT_BLACK);
+      frame.fillRect(x - dx - 1, tickY - dy - 1, 2, 2, TFT_BLACK);
+    }
+  }
+}
+
+void stationFieldText(const StationData& station, int field, char* buffer, size_t size) {
+  char value[FIELD_TEXT_SIZE];
+  stationFieldValue(station, field, value, sizeof(value));
+  snprintf(buffer, size, "%s%s", FIELD_LABELS[field], value);
+}
+
+void stationFieldValue(const StationData& station, int field, char* buffer, size_t size) {
+  const char* unit = speedUnitLabel(station.displayUnit);
+  char value[12];
+
+  switch (field) {
+    case FIELD_STATION_NAME:
+      snprintf(buffer, size, "%s", station.stationName);
+      return;
+    case FIELD_WIND_DIR:
+      snprintf(buffer, size, "%d", station.windDirection);
+      return;
+    case FIELD_WIND_SPEED:
+      formatTenths(value, sizeof(value), convertWindSpeed(station.windSpeed, station.displayUnit));
+      snprintf(buffer, size, "%s %s", value, unit);
+      return;
+    case FIELD_WIND_GUST:
+      if (station.windGust == VALUE_MISSING) {
+        snprintf(buffer, size, "--"); // v2.1.5: Simplified null display
+        return;
+      }
+      formatTenths(value, sizeof(value), convertWindSpeed(station.windGust, station.displayUnit));
+      snprintf(buffer, size, "%s %s", value, unit);
+      return;
+    case FIELD_AIR_TEMP:
+      if (station.temperature == VALUE_MISSING) {
+        snprintf(buffer, size, "--");
+        return;
+      }
+      formatTenths(value, sizeof(value), station.temperature);
+      snprintf(buffer, size, "%s", value);
+      return;
+  }
+  buffer[0] = '\0';
+}
+
+// ===============================================================================
+// STATUS FOOTER
+// ===============================================================================
+
+void drawStatusFooter(TFT_eSprite& sprite, FrameBuffer& frame, const FooterStatus& status) {
+  // v2.1.3: Revert footer to bitmap font for better fit
+  sprite.setFreeFont(); // Reset to default bitmap font
+  sprite.setTextSize(1);
+  sprite.setTextColor(TFT_BLACK); // v2.2.0: Frame buffer text doesn't leave the sprite's colour set
+
+  // v2.1.8 Footer layout: WiFi label + signal bars for best clarity
+  sprite.drawString(status.updated, FOOTER_UPDATED_X, FOOTER_TEXT_Y); // v2.1.8: Bitmap font, bottom positioned
+  sprite.drawString("WiFi:", 150, 460);         // v2.1.8: WiFi label
+  drawWiFiSignalBars(sprite, frame, status.wifiBars, FOOTER_WIFI_X, FOOTER_WIFI_Y); // v2.1.8: Visual WiFi signal bars
+  sprite.drawString(status.power, 210, 460);
+  sprite.drawString(status.deviceId, 320, 460);
+  sprite.drawString("v2.1.8", 420, 460);
+
+  // v2.2.0: Staleness marker while the last-known-good data is kept up
+  sprite.drawString(status.stale, FOOTER_STALE_X, FOOTER_TEXT_Y);
+}
+
+// Dirty-region box of each footer field, wide enough for the longest text it formats
+LayoutRect footerFieldRect(int field) {
+  switch (field) {
+    case FOOTER_UPDATED:
+      return {(int16_t)FOOTER_UPDATED_X, (int16_t)(FOOTER_TEXT_Y - 4), 136, 16};
+    case FOOTER_WIFI:
+      return {(int16_t)(FOOTER_WIFI_X - 1), (int16_t)(FOOTER_TEXT_Y - 4), 24, 16};
+    case FOOTER_STALE:
+      return {(int16_t)FOOTER_STALE_X, (int16_t)(FOOTER_TEXT_Y - 4), 96, 16};
+  }
+  return {0, 0, 0, 0};
+}
+
+// v2.1.8: WiFi signal strength indicator using vertical bars
+static void drawWiFiSignalBars(TFT_eSprite& sprite, FrameBuffer& frame, int bars, int x, int y) {
+  if (bars < 0) {
+    // Draw "X" for disconnected WiFi
+    sprite.drawLine(x, y, x + 6, y - 6, TFT_BLACK);
+    sprite.drawLine(x + 6, y, x, y - 6, TFT_BLACK);
+    return;
+  }
+
+  // Draw 4 vertical bars with increasing heights
+  int barWidth = 2;
+  int barSpacing = 1;
+  int maxHeight = 8;
+
+  for (int i = 0; i < 4; i++) {
+    int barHeight = (i + 1) * (maxHeight / 4); // Heights: 2, 4, 6, 8
+    int barX = x + i * (barWidth + barSpacing);
+
+    if (i < bars) {
+      // Draw filled bar for active signal
+      frame.fillRect(barX, y - barHeight, barWidth, barHeight, TFT_BLACK);
+    } else {
+      // Draw outline bar for inactive signal
+      frame.drawRect(barX, y - barHeight, barWidth, barHeight, TFT_BLACK);
+    }
+  }
+}
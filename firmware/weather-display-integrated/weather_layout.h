@@ -0,0 +1,139 @@
+/**
+ * Weather Layout v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * Station grid layouts and status footer. Everything it draws comes in
+ * as arguments (station model, footer texts, the sprite and its FrameBuffer),
+ * so the host benchmark renders the same frame against a mock sprite.
+ */
+
+#pragma once
+
+#include "frame_buffer.h"
+#include "weather_model.h"
+
+// One text line per field per station
+enum StationField {
+  FIELD_STATION_NAME = 0,
+  FIELD_WIND_DIR,
+  FIELD_WIND_SPEED,
+  FIELD_WIND_GUST,
+  FIELD_AIR_TEMP,
+  FIELDS_PER_STATION
+};
+#define FIELD_TEXT_SIZE 48 // Longest field line plus terminator
+
+struct LayoutRect {
+  int16_t x;
+  int16_t y;
+  int16_t w;
+  int16_t h;
+};
+
+// Station grid layouts - geometry, fonts and field order per layout. A region
+// gets the first layout that holds all its stations; slots fill row by row.
+struct LayoutField {
+  uint8_t field;                // StationField
+  const GFXfont* font;
+};
+
+struct StationLayout {
+  const char* name;             // "rows x columns" (debug output, dirty-region hash seed)
+  uint8_t columns;
+  uint8_t rows;
+  int16_t x;                    // Station name of the top-left slot
+  int16_t y;
+  int16_t columnPitch;          // Column start to column start
+  int16_t columnWidth;          // Name rule, separator position and field rectangles
+  int16_t rowPitch;
+  int16_t separatorHeight;      // Vertical rule right of each slot but the last column
+  const GFXfont* nameFont;
+  int16_t fieldOffset;          // First field line below the station name
+  int16_t fieldSpacing;
+  uint8_t fieldCount;
+  LayoutField fields[FIELDS_PER_STATION - 1]; // Drawn top to bottom
+  int16_t trendOffset;          // Wind trend box below the station name...
+  int16_t trendHeight;          // ...its height (0 = no trend)
+  bool trendDirections;         // Direction ticks under the sparkline
+};
+
+constexpr StationLayout STATION_LAYOUTS[] = {
+  // v2.1.3 three columns: 260px each + margins, 50% increased line spacing
+  {"1x3", 3, 1, 10, 15, 265, 260, 0, 421, &FreeSansBold18pt7b, 40, 42, 4,
+   {{FIELD_WIND_DIR, &FreeSans12pt7b}, {FIELD_WIND_SPEED, &FreeSans12pt7b},
+    {FIELD_WIND_GUST, &FreeSans12pt7b}, {FIELD_AIR_TEMP, &FreeSans12pt7b}},
+   200, 90, true},
+  // Grids: half-height slots, wind speed and gust first, a sparkline strip only
+  {"2x2", 2, 2, 10, 15, 395, 390, 213, 205, &FreeSansBold18pt7b, 40, 36, 4,
+   {{FIELD_WIND_SPEED, &FreeSans12pt7b}, {FIELD_WIND_GUST, &FreeSans12pt7b},
+    {FIELD_WIND_DIR, &FreeSans12pt7b}, {FIELD_AIR_TEMP, &FreeSans12pt7b}},
+   176, 24, false},
+  {"2x3", 3, 2, 10, 15, 265, 260, 213, 205, &FreeSansBold18pt7b, 40, 36, 4,
+   {{FIELD_WIND_SPEED, &FreeSans12pt7b}, {FIELD_WIND_GUST, &FreeSans12pt7b},
+    {FIELD_WIND_DIR, &FreeSans12pt7b}, {FIELD_AIR_TEMP, &FreeSans12pt7b}},
+   176, 24, false}
+};
+constexpr int NUM_STATION_LAYOUTS = sizeof(STATION_LAYOUTS) / sizeof(STATION_LAYOUTS[0]);
+
+constexpr int layoutSlots(const StationLayout& layout) {
+  return layout.columns * layout.rows;
+}
+constexpr int largestLayoutSlots(int index = 0) {
+  return index == NUM_STATION_LAYOUTS ? 0
+    : (layoutSlots(STATION_LAYOUTS[index]) > largestLayoutSlots(index + 1)
+         ? layoutSlots(STATION_LAYOUTS[index]) : largestLayoutSlots(index + 1));
+}
+static_assert(largestLayoutSlots() == STATION_SLOTS, "STATION_SLOTS (weather_model.h) must match the largest layout");
+static_assert(STATION_SLOTS * FIELDS_PER_STATION <= 32, "Changed-field masks are 32 bits");
+
+// Footer content, formatted by the caller (the texts the dirty-region hashes cover)
+struct FooterStatus {
+  const char* updated;      // "Updated: HH:MM UTC"
+  int wifiBars;             // 0-4, -1 = disconnected
+  const char* power;        // "Mem:xx%" or "Bat:xx%"
+  const char* deviceId;     // "ID:xxxxxx"
+  const char* stale;        // Staleness marker, "" while the data is current
+};
+
+// Footer fields with a dirty region of their own
+enum FooterField {
+  FOOTER_UPDATED,
+  FOOTER_WIFI,
+  FOOTER_STALE
+};
+
+// Layout for a station array of STATION_SLOTS entries (by its last used slot)
+const StationLayout& stationLayoutFor(const StationData* stations);
+
+// Static layer (from the cache when the station set is unchanged) plus values.
+// history (one per station slot) draws the wind trends; NULL leaves them out.
+void drawWeatherData(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                     const StationHistory* history);
+// Names, labels, rules and trend axes - everything that only changes with the station set
+void drawStaticLayer(FrameBuffer& frame, const StationData* stations);
+// Field values, drawn right after their labels, and the wind trends
+void drawValueLayer(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                    const StationHistory* history);
+// Incremental redraw over a frame that still holds the previous weather frame:
+// each field in changedFields (bit slot * FIELDS_PER_STATION + field), each
+// trend in changedTrends (bit slot) and the footer band are restored from the
+// static layer cache, then redrawn. False when the cache doesn't hold this
+// station set (or a name changed) - draw the whole frame with drawWeatherData()
+// instead. The caller redraws the footer.
+bool drawChangedFields(TFT_eSprite& sprite, FrameBuffer& frame, const StationData* stations,
+                       const StationHistory* history, uint32_t changedFields, uint32_t changedTrends);
+void drawStatusFooter(TFT_eSprite& sprite, FrameBuffer& frame, const FooterStatus& status);
+
+// Bounding box of one field line, covering degree symbols drawn above the text
+// (the unit of partial refresh and incremental redraw); empty for a field the
+// layout doesn't show
+LayoutRect stationFieldRect(const StationLayout& layout, int slot, int field);
+// Wind trend box of a slot (empty when the layout has none)
+LayoutRect stationTrendRect(const StationLayout& layout, int slot);
+// Bounding box of a footer field, as drawStatusFooter() places it
+LayoutRect footerFieldRect(int field);
+
+// Text of one field line (label + value), shared by the dirty-region hashes
+void stationFieldText(const StationData& station, int field, char* buffer, size_t size);
+// Value part of a field line, as drawn after the static label
+void stationFieldValue(const StationData& station, int field, char* buffer, size_t size);
@@ -0,0 +1,312 @@
+/**
+ * Station Model and Region Payload Parsing v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * See weather_model.h.
+ */
+
+#include "weather_model.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+// ===============================================================================
+// BINARY REGION PAYLOAD
+// ===============================================================================
+
+// Station record fields in delta-mask bit order: offset in a full record, bytes on the wire
+static const uint8_t STATION_FIELD_OFFSET[REGION_BINARY_DELTA_FIELDS] = {0, 16, 18, 20, 22, 24};
+static const uint8_t STATION_FIELD_SIZE[REGION_BINARY_DELTA_FIELDS] = {16, 2, 2, 2, 2, 6};
+
+static void decodeStationField(StationData& station, int field, const uint8_t* data) {
+  char text[17];
+
+  switch (field) {
+    case 0: // REGION_DELTA_STATION_ID
+      memcpy(text, data, 16);
+      text[16] = '\0';
+      strlcpy(station.stationName, stationDisplayName(text), sizeof(station.stationName));
+      return;
+    case 1: { // REGION_DELTA_WIND_AVG - already tenths of m/s on the wire
+      uint16_t speed = readUint16LE(data);
+      station.windSpeed = (int16_t)(speed > INT16_MAX ? INT16_MAX : speed);
+      return;
+    }
+    case 2: { // REGION_DELTA_WIND_GUST
+      uint16_t gust = readUint16LE(data);
+      station.windGust = (gust == REGION_BINARY_GUST_NONE) ? VALUE_MISSING
+                                                           : (int16_t)(gust > INT16_MAX ? INT16_MAX : gust);
+      return;
+    }
+    case 3: { // REGION_DELTA_WIND_DIR - no direction maps to 0, as the JSON path does for null
+      int16_t direction = (int16_t)readUint16LE(data);
+      station.windDirection = (direction < 0) ? 0 : direction;
+      return;
+    }
+    case 4: { // REGION_DELTA_AIR_TEMP
+      int16_t temp = (int16_t)readUint16LE(data);
+      if (temp == REGION_BINARY_TEMP_NONE || temp < -600 || temp > 600) {
+        station.temperature = VALUE_MISSING; // Missing or outside -60°C to +60°C
+      } else {
+        station.temperature = temp;
+      }
+      return;
+    }
+    case 5: // REGION_DELTA_TIME
+      memcpy(text, data, 6);
+      text[5] = '\0';
+      setLastUpdateTime(station, text, 0);
+      return;
+  }
+}
+
+// End of the delta station records (slot, change mask, changed fields), 0 when truncated
+static size_t deltaStationsEnd(const uint8_t* payload, size_t length, int recordCount) {
+  size_t offset = REGION_BINARY_HEADER_SIZE;
+  for (int i = 0; i < recordCount; i++) {
+    if (offset + REGION_BINARY_DELTA_RECORD_HEADER > length) return 0;
+    uint8_t changed = payload[offset + 1];
+    offset += REGION_BINARY_DELTA_RECORD_HEADER;
+    for (int field = 0; field < REGION_BINARY_DELTA_FIELDS; field++) {
+      if (changed & (1 << field)) offset += STATION_FIELD_SIZE[field];
+    }
+  }
+  return offset <= length ? offset : 0;
+}
+
+bool parseRegionBinary(const uint8_t* payload, size_t length, RegionHeader& header, StationData* stations) {
+  if (length < REGION_BINARY_HEADER_SIZE || payload[0] != 'W' || payload[1] != 'B' ||
+      payload[2] != REGION_BINARY_VERSION) {
+    return false;
+  }
+
+  // Full payloads carry every station; deltas only the changed fields of changed ones
+  int stationCount = payload[4];
+  header.delta = (payload[3] & REGION_BINARY_FLAG_DELTA) != 0;
+  size_t stationsEnd = header.delta ? deltaStationsEnd(payload, length, stationCount)
+                                    : REGION_BINARY_HEADER_SIZE + stationCount * REGION_BINARY_STATION_SIZE;
+  if (stationsEnd == 0 || length < stationsEnd) {
+    return false;
+  }
+
+  header.commands.count = 0;
+  if ((payload[3] & REGION_BINARY_FLAG_COMMANDS) &&
+      !parseCommandBlock(payload + stationsEnd, length - stationsEnd, header.commands)) {
+    return false;
+  }
+
+  char text[17];
+  memcpy(text, payload + 10, 16);
+  text[16] = '\0';
+  strlcpy(header.regionId, text, sizeof(header.regionId));
+  header.regionName[0] = '\0';
+  formatRegionDate(header.date, sizeof(header.date), readUint16LE(payload + 6), payload[8], payload[9]);
+  header.identify = (payload[3] & REGION_BINARY_FLAG_IDENTIFY) != 0;
+  SpeedUnit displayUnit = regionDisplayUnit(header.regionId); // Resolved once per response
+
+  if (header.delta) {
+    const uint8_t* record = payload + REGION_BINARY_HEADER_SIZE;
+    for (int i = 0; i < stationCount; i++) {
+      int slot = record[0];
+      uint8_t changed = record[1];
+      const uint8_t* field = record + REGION_BINARY_DELTA_RECORD_HEADER;
+      for (int f = 0; f < REGION_BINARY_DELTA_FIELDS; f++) {
+        if (!(changed & (1 << f))) continue;
+        if (slot < STATION_SLOTS) decodeStationField(stations[slot], f, field);
+        field += STATION_FIELD_SIZE[f];
+      }
+      if (slot < STATION_SLOTS) stations[slot].displayUnit = displayUnit;
+      record = field;
+    }
+    return true;
+  }
+
+  for (int i = 0; i < STATION_SLOTS; i++) {
+    if (i >= stationCount) {
+      stations[i].stationName[0] = '\0'; // Layout is picked by the used slots
+      continue;
+    }
+    const uint8_t* station = payload + REGION_BINARY_HEADER_SIZE + i * REGION_BINARY_STATION_SIZE;
+    for (int field = 0; field < REGION_BINARY_DELTA_FIELDS; field++) {
+      decodeStationField(stations[i], field, station + STATION_FIELD_OFFSET[field]);
+    }
+    stations[i].displayUnit = displayUnit;
+  }
+
+  return true;
+}
+
+bool regionBinaryHasActions(const uint8_t* payload, size_t length) {
+  return length > 3 && (payload[3] & (REGION_BINARY_FLAG_IDENTIFY | REGION_BINARY_FLAG_COMMANDS)) != 0;
+}
+
+bool parseCommandBlock(const uint8_t* block, size_t length, DeviceCommandList& commands) {
+  commands.count = 0;
+  if (length < REGION_BINARY_COMMANDS_HEADER_SIZE ||
+      length < (size_t)(REGION_BINARY_COMMANDS_HEADER_SIZE + block[0] * REGION_BINARY_COMMAND_SIZE)) {
+    return false;
+  }
+
+  for (int i = 0; i < block[0] && i < REGION_MAX_COMMANDS; i++) {
+    const uint8_t* record = block + REGION_BINARY_COMMANDS_HEADER_SIZE + i * REGION_BINARY_COMMAND_SIZE;
+    DeviceCommand& command = commands.items[commands.count++];
+    command.id = readUint32LE(record);
+    command.type = (record[4] <= COMMAND_REFRESH) ? (DeviceCommandType)record[4] : COMMAND_NONE;
+    command.value = readUint32LE(record + 8);
+    memcpy(command.text, record + 12, sizeof(command.text) - 1);
+    command.text[sizeof(command.text) - 1] = '\0';
+  }
+  return true;
+}
+
+DeviceCommandType commandTypeFromName(const char* name) {
+  if (strcmp(name, "identify") == 0) return COMMAND_IDENTIFY;
+  if (strcmp(name, "region") == 0) return COMMAND_REGION;
+  if (strcmp(name, "interval") == 0) return COMMAND_INTERVAL;
+  if (strcmp(name, "refresh") == 0) return COMMAND_REFRESH;
+  return COMMAND_NONE;
+}
+
+// ===============================================================================
+// WIND HISTORY
+// ===============================================================================
+
+static uint8_t quantizeSpeed(int16_t tenths) {
+  if (tenths == VALUE_MISSING) return HISTORY_NONE;
+  int steps = (tenths + HISTORY_SPEED_STEP / 2) / HISTORY_SPEED_STEP;
+  if (steps < 0) return 0;
+  return steps >= HISTORY_NONE ? HISTORY_NONE - 1 : (uint8_t)steps;
+}
+
+static void clearWindHistory(StationHistory& history, uint32_t stationHash, uint32_t bucket) {
+  memset(history.samples, HISTORY_NONE, sizeof(history.samples));
+  history.stationHash = stationHash;
+  history.lastBucket = bucket;
+  history.head = 0;
+}
+
+void recordWindHistory(StationHistory& history, const StationData& station, uint32_t bucket) {
+  if (station.stationName[0] == '\0') {
+    if (history.stationHash != 0) clearWindHistory(history, 0, bucket);
+    return;
+  }
+
+  uint32_t stationHash = fnv1aHash(station.stationName, strlen(station.stationName));
+  if (history.stationHash != stationHash || bucket < history.lastBucket) {
+    clearWindHistory(history, stationHash, bucket);
+  }
+
+  uint32_t elapsed = bucket - history.lastBucket;
+  if (elapsed > HISTORY_SAMPLES) elapsed = HISTORY_SAMPLES;
+  for (uint32_t i = 0; i < elapsed; i++) {
+    history.head = (history.head + 1) % HISTORY_SAMPLES;
+    history.samples[history.head] = {HISTORY_NONE, HISTORY_NONE, 0};
+  }
+  history.lastBucket = bucket;
+
+  // Latest data in a bucket wins
+  WindSample& sample = history.samples[history.head];
+  sample.avg = quantizeSpeed(station.windSpeed);
+  sample.gust = quantizeSpeed(station.windGust);
+  sample.direction = (uint8_t)(((station.windDirection % 360 + 360) % 360 * 256 + 180) / 360);
+}
+
+WindSample windHistorySample(const StationHistory& history, int age) {
+  return history.samples[(history.head + HISTORY_SAMPLES - age % HISTORY_SAMPLES) % HISTORY_SAMPLES];
+}
+
+// ===============================================================================
+// UNITS AND FORMATTING
+// ===============================================================================
+
+// Backend v2.0.0 always returns m/s, convert to user-friendly regional units
+// using the factors from SPEED_UNITS
+int32_t convertWindSpeed(int32_t tenthsMs, SpeedUnit targetUnit) {
+  int64_t scaled = (int64_t)tenthsMs * SPEED_UNITS[targetUnit].factor;
+  return (int32_t)((scaled + SPEED_FACTOR_SCALE / 2) / SPEED_FACTOR_SCALE);
+}
+
+const char* speedUnitLabel(SpeedUnit unit) {
+  return SPEED_UNITS[unit].label;
+}
+
+int16_t toTenths(float value) {
+  long tenths = lroundf(value * 10.0f);
+  if (tenths < (long)INT16_MIN + 1) return INT16_MIN + 1; // INT16_MIN is VALUE_MISSING
+  if (tenths > (long)INT16_MAX) return INT16_MAX;
+  return (int16_t)tenths;
+}
+
+void formatTenths(char* buffer, size_t size, int32_t tenths) {
+  uint32_t magnitude = (tenths < 0) ? -tenths : tenths;
+  snprintf(buffer, size, "%s%lu.%lu", (tenths < 0) ? "-" : "",
+           (unsigned long)(magnitude / 10), (unsigned long)(magnitude % 10));
+}
+
+void setLastUpdateTime(StationData& station, const char* text, size_t offset) {
+  if (strlen(text) >= offset + 5) {
+    snprintf(station.lastUpdateTime, sizeof(station.lastUpdateTime), "%.5s UTC", text + offset);
+  } else {
+    strlcpy(station.lastUpdateTime, "--:-- UTC", sizeof(station.lastUpdateTime));
+  }
+}
+
+void formatRegionDate(char* buffer, size_t size, int year, int month, int day) {
+  static const char* monthNames[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun",
+                                     "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+  if (month < 1 || month > 12) {
+    buffer[0] = '\0';
+    return;
+  }
+  snprintf(buffer, size, "%02d %s %d", day, monthNames[month - 1], year);
+}
+
+// ===============================================================================
+// HASHING AND TABLE LOOKUPS
+// ===============================================================================
+
+uint32_t fnv1aUpdate(uint32_t hash, const char* data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    hash ^= (uint8_t)data[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+uint32_t fnv1aHash(const char* data, size_t length) {
+  return fnv1aUpdate(2166136261UL, data, length);
+}
+
+uint16_t readUint16LE(const uint8_t* data) {
+  return (uint16_t)data[0] | ((uint16_t)data[1] << 8);
+}
+
+uint32_t readUint32LE(const uint8_t* data) {
+  return (uint32_t)readUint16LE(data) | ((uint32_t)readUint16LE(data + 2) << 16);
+}
+
+const StationInfo* findStation(const char* stationId) {
+  uint32_t hash = fnv1aHash(stationId, strlen(stationId));
+  for (int i = 0; i < NUM_STATIONS; i++) {
+    if (STATIONS[i].idHash == hash) return &STATIONS[i];
+  }
+  return NULL;
+}
+
+const RegionInfo* findRegion(const char* regionId) {
+  uint32_t hash = fnv1aHash(regionId, strlen(regionId));
+  for (int i = 0; i < NUM_REGIONS; i++) {
+    if (REGIONS[i].idHash == hash) return &REGIONS[i];
+  }
+  return NULL;
+}
+
+const char* stationDisplayName(const char* stationId) {
+  const StationInfo* station = findStation(stationId);
+  return station ? station->displayName : stationId;
+}
+
+SpeedUnit regionDisplayUnit(const char* regionId) {
+  const RegionInfo* region = findRegion(regionId);
+  return region ? region->displayUnit : UNIT_MPS;
+}
@@ -0,0 +1,154 @@
+/**
+ * Station Model and Region Payload Parsing v2.2.0
+ * Weather Display Integrated - XIAO ESP32C3 + 7.5" ePaper
+ *
+ * Plain C++ with no Arduino, WiFi or display dependencies, so the sketch and
+ * the host benchmark (firmware/bench) run the same parse and formatting code.
+ * The JSON path is in region_json.h - the only part that needs ArduinoJson.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "regions_generated.h" // Station/region/unit tables generated from the backend
+
+// Plain-old-data station model - fixed-point values and char buffers, so it
+// copies straight into RTC memory and the display queue and renders without heap
+#define VALUE_MISSING INT16_MIN  // Null/unavailable fixed-point value
+#define STATION_SLOTS 6          // Stations per region the display holds (largest layout in weather_layout.h)
+static_assert(REGION_MAX_STATIONS <= STATION_SLOTS, "A configured region has more stations than any layout");
+struct StationData {
+  char stationName[24];     // Display name, "" = slot unused
+  int16_t temperature;      // Tenths of °C, VALUE_MISSING if null/unavailable
+  int16_t windSpeed;        // Tenths of m/s, always available from backend (0 = calm)
+  int16_t windGust;         // Tenths of m/s, VALUE_MISSING if null/unavailable (instantaneous only)
+  int16_t windDirection;    // Degrees, always available (0-359)
+  SpeedUnit displayUnit;    // Regional display unit
+  char lastUpdateTime[12];  // "HH:MM UTC"
+};
+
+// Wind history per station slot - quantized samples in fixed time buckets, kept
+// in RTC memory across deep sleep for the trend sparklines (the backend sends
+// current readings only)
+#define HISTORY_SAMPLES 40        // Ring length per station (2 hours of 3-minute buckets)
+#define HISTORY_NONE 0xFF         // No sample (slept through the bucket, fetch failed, no gust)
+#define HISTORY_SPEED_STEP 5      // Tenths of m/s per quantized step (0.5 m/s, up to 127 m/s)
+struct WindSample {
+  uint8_t avg;              // HISTORY_SPEED_STEP steps, HISTORY_NONE = no sample in the bucket
+  uint8_t gust;             // HISTORY_SPEED_STEP steps, HISTORY_NONE also when the station has none
+  uint8_t direction;        // 256ths of a turn
+};
+struct StationHistory {
+  uint32_t stationHash;     // FNV-1a of the station name the samples belong to (0 = empty)
+  uint32_t lastBucket;      // Time bucket of the newest sample
+  uint8_t head;             // Ring index of the newest sample
+  WindSample samples[HISTORY_SAMPLES];
+};
+
+// Commands queued for this device on the backend, delivered with the region
+// payload or the command long-poll until acknowledged (X-Command-Ack)
+enum DeviceCommandType : uint8_t {
+  COMMAND_NONE = 0,         // Unknown type (newer backend) - acknowledged, not applied
+  COMMAND_IDENTIFY = 1,
+  COMMAND_REGION = 2,       // Region reassignment, region ID in text
+  COMMAND_INTERVAL = 3,     // Poll interval override, seconds in value (0 = regional schedule)
+  COMMAND_REFRESH = 4       // Full panel refresh
+};
+#define REGION_MAX_COMMANDS 4 // Backend keeps at most one pending command per type
+struct DeviceCommand {
+  uint32_t id;              // Backend sequence, increasing per device
+  DeviceCommandType type;
+  uint32_t value;
+  char text[16];
+};
+struct DeviceCommandList {
+  DeviceCommand items[REGION_MAX_COMMANDS];
+  uint8_t count;
+};
+
+// Region-level fields of one payload (the stations go into a caller array)
+struct RegionHeader {
+  char regionId[24];
+  char regionName[32];      // "" when the payload has none (binary)
+  char date[16];            // "DD MMM YYYY", "" when the timestamp has no valid date
+  bool identify;            // Identify request pending for this device
+  bool delta;               // Stations were merged as changes (REGION_BINARY_FLAG_DELTA)
+  DeviceCommandList commands; // Pending commands (none for older backends)
+};
+
+// Compact binary region payload - layout documented in backend/src/utils/regionBinary.ts
+#define REGION_BINARY_CONTENT_TYPE "application/octet-stream"
+#define REGION_BINARY_VERSION 1
+#define REGION_BINARY_HEADER_SIZE 28
+#define REGION_BINARY_STATION_SIZE 32
+#define REGION_BINARY_COMMANDS_HEADER_SIZE 4
+#define REGION_BINARY_COMMAND_SIZE 28
+#define REGION_BINARY_COMMANDS_MAX_SIZE (REGION_BINARY_COMMANDS_HEADER_SIZE + REGION_MAX_COMMANDS * REGION_BINARY_COMMAND_SIZE)
+#define REGION_BINARY_MAX_SIZE (REGION_BINARY_HEADER_SIZE + STATION_SLOTS * REGION_BINARY_STATION_SIZE + \
+                                REGION_BINARY_COMMANDS_MAX_SIZE)
+#define REGION_BINARY_FLAG_IDENTIFY 0x01
+#define REGION_BINARY_FLAG_COMMANDS 0x02 // Command block follows the stations
+#define REGION_BINARY_FLAG_DELTA 0x04    // Stations are changes against the version in If-None-Match
+
+// Delta station record: display slot, changed-field mask, then the changed fields
+// only, each encoded as in a full station record, in mask bit order
+#define REGION_BINARY_DELTA_RECORD_HEADER 2
+#define REGION_BINARY_DELTA_FIELDS 6
+#define REGION_DELTA_STATION_ID 0x01      // New station in the slot - every field follows
+#define REGION_DELTA_WIND_AVG 0x02
+#define REGION_DELTA_WIND_GUST 0x04
+#define REGION_DELTA_WIND_DIR 0x08
+#define REGION_DELTA_AIR_TEMP 0x10
+#define REGION_DELTA_TIME 0x20
+#define REGION_BINARY_GUST_NONE 0xFFFF
+#define REGION_BINARY_TEMP_NONE 0x7FFF
+
+// Fixed offsets, no JSON document or heap. Fills up to STATION_SLOTS entries
+// of stations and clears the rest; false on a bad header or truncated body. A
+// delta payload merges into stations, which must hold the data of the version
+// it is based on.
+bool parseRegionBinary(const uint8_t* payload, size_t length, RegionHeader& header, StationData* stations);
+// Identify flag or command block set in a binary payload's header - it must be
+// applied even when its hash matches the last one
+bool regionBinaryHasActions(const uint8_t* payload, size_t length);
+// Command block alone (the binary long-poll body, or the trailer of a region
+// payload). Keeps the first REGION_MAX_COMMANDS; false when truncated.
+bool parseCommandBlock(const uint8_t* block, size_t length, DeviceCommandList& commands);
+// Backend command name ("identify", "region", ...) to its type, COMMAND_NONE if unknown
+DeviceCommandType commandTypeFromName(const char* name);
+
+// Samples the station's data into the bucket. A later bucket moves the ring on
+// (skipped buckets stay empty); a different station, or an unused slot, starts over.
+void recordWindHistory(StationHistory& history, const StationData& station, uint32_t bucket);
+// Sample age buckets old (0 = newest)
+WindSample windHistorySample(const StationHistory& history, int age);
+
+// Wind speed in tenths of m/s to tenths of the target unit, rounded to nearest
+int32_t convertWindSpeed(int32_t tenthsMs, SpeedUnit targetUnit);
+const char* speedUnitLabel(SpeedUnit unit);
+
+// Backend float to tenths, clamped to the fixed-point range
+int16_t toTenths(float value);
+// One-decimal text of a tenths value ("-3.5") without float formatting
+void formatTenths(char* buffer, size_t size, int32_t tenths);
+
+// FNV-1a 32-bit hash for cheap change detection across wakes
+uint32_t fnv1aUpdate(uint32_t hash, const char* data, size_t length);
+uint32_t fnv1aHash(const char* data, size_t length);
+
+uint16_t readUint16LE(const uint8_t* data);
+uint32_t readUint32LE(const uint8_t* data);
+
+// Table lookups by FNV-1a of the ID (see regions_generated.h)
+const StationInfo* findStation(const char* stationId);
+const RegionInfo* findRegion(const char* regionId);
+// Display name for a backend station ID (the ID itself when unknown)
+const char* stationDisplayName(const char* stationId);
+// Regional display unit (km/h for alpine, knots for marine); m/s for unknown regions
+SpeedUnit regionDisplayUnit(const char* regionId);
+
+// "HH:MM UTC" from the HH:MM found at offset in text ("--:-- UTC" if too short)
+void setLastUpdateTime(StationData& station, const char* text, size_t offset);
+// "DD MMM YYYY" ("" for an invalid month)
+void formatRegionDate(char* buffer, size_t size, int year, int month, int day);